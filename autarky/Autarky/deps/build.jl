@@ -0,0 +1,12 @@
+# Build the MA97 analysis cache against the HSL library of HSL_jll (`] build Autarky`)
+import HSL_jll, Libdl
+
+# The shim is linked with GNU ld flags (see ma97_cache/Makefile): Linux only
+if Sys.islinux() && HSL_jll.is_available()
+    make_dir = joinpath(@__DIR__, "ma97_cache")
+    run(`make -C $make_dir DLEXT=$(Libdl.dlext) HSL_LIBDIR=$(dirname(HSL_jll.libhsl_path)) HSL_INCLUDE=$(joinpath(HSL_jll.artifact_dir, "include"))`)
+elseif !Sys.islinux()
+    println("Warning: the MA97 analysis cache is built on Linux only, it is not built on $(Sys.KERNEL).")
+else
+    println("Warning: the HSL library is not available, the MA97 analysis cache is not built.")
+end
@@ -0,0 +1,300 @@
+/*
+ * MA97 symbolic analysis cache for Ipopt.
+ *
+ * The library exports the MA97 entry points that Ipopt loads from its `hsllib` and forwards them to
+ * the HSL library. `ma97_analyse_d` is computed once per sparsity pattern (and analysis controls):
+ * later analyses of the same pattern in the process return the cached `akeep`, so the ordering
+ * (METIS, AMD) and the symbolic factorization are skipped. Finalising a solver frees its numeric
+ * factors only; cached analyses live until `ma97_cache_clear`.
+ *
+ * The parallel thresholds of the factorization and solve (control.factor_min and control.solve_min),
+ * which Ipopt does not expose as options, can be overridden with `ma97_cache_set_thresholds`.
+ *
+ * The other HSL symbols (ma27, ma57, mc19, ...) are found in libhsl, which the library is linked against.
+ */
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hsl_ma97d.h"
+
+#define MA97_CACHE_SIZE 16
+
+typedef void (*analyse_t)(int, int, const int[], const int[], double[], void **,
+                          const struct ma97_control_d *, struct ma97_info_d *, int[]);
+typedef void (*default_control_t)(struct ma97_control_d *);
+typedef void (*factor_t)(int, const int[], const int[], const double[], void **, void **,
+                         const struct ma97_control_d *, struct ma97_info_d *, double[]);
+typedef void (*factor_solve_t)(int, const int[], const int[], const double[], int, double[], int,
+                               void **, void **, const struct ma97_control_d *, struct ma97_info_d *,
+                               double[]);
+typedef void (*solve_t)(int, int, double[], int, void **, void **, const struct ma97_control_d *,
+                        struct ma97_info_d *);
+typedef void (*free_t)(void **);
+typedef void (*finalise_t)(void **, void **);
+
+static struct {
+    default_control_t default_control;
+    analyse_t analyse;
+    factor_t factor;
+    factor_solve_t factor_solve;
+    solve_t solve;
+    free_t free_akeep;
+    free_t free_fkeep;
+    finalise_t finalise;
+} hsl;
+
+/* Analysis of one sparsity pattern */
+struct entry {
+    uint64_t hash;
+    int n, check, f_arrays, ordering, nemin;
+    int *ptr, *row;           /* Copy of the pattern, compared on hash matches */
+    void *akeep;
+    struct ma97_info_d info;  /* Info of the analysis, returned on reuse */
+    int in_use;               /* Number of solvers holding akeep */
+    unsigned long last_use;
+};
+
+static struct entry cache[MA97_CACHE_SIZE];
+static unsigned long clock_ticks = 0;
+static long hits = 0, misses = 0;
+static long factor_min = -1, solve_min = -1;  /* Overrides of the parallel thresholds (-1: keep) */
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* FNV-1a hash of the pattern and of the controls of the analysis */
+static uint64_t pattern_hash(int n, int nz, const int ptr[], const int row[], const int key[], int nkey)
+{
+    uint64_t h = 14695981039346656037ULL;
+    const unsigned char *bytes[3] = {(const unsigned char *)key, (const unsigned char *)ptr,
+                                     (const unsigned char *)row};
+    size_t sizes[3] = {nkey * sizeof(int), (size_t)(n + 1) * sizeof(int), (size_t)nz * sizeof(int)};
+    for (int k = 0; k < 3; k++)
+        for (size_t i = 0; i < sizes[k]; i++) {
+            h ^= bytes[k][i];
+            h *= 1099511628211ULL;
+        }
+    return h;
+}
+
+static struct entry *find_entry(void *akeep)
+{
+    for (int k = 0; k < MA97_CACHE_SIZE; k++)
+        if (cache[k].akeep != NULL && cache[k].akeep == akeep) return &cache[k];
+    return NULL;
+}
+
+static void free_entry(struct entry *e)
+{
+    hsl.free_akeep(&e->akeep);
+    free(e->ptr);
+    free(e->row);
+    memset(e, 0, sizeof(*e));
+}
+
+/* Free slot, or the least recently used analysis that no solver holds (NULL if all are held) */
+static struct entry *free_slot(void)
+{
+    struct entry *lru = NULL;
+    for (int k = 0; k < MA97_CACHE_SIZE; k++) {
+        if (cache[k].akeep == NULL) return &cache[k];
+        if (cache[k].in_use == 0 && (lru == NULL || cache[k].last_use < lru->last_use)) lru = &cache[k];
+    }
+    if (lru != NULL) free_entry(lru);
+    return lru;
+}
+
+/*
+ * Load the MA97 routines of the HSL library at `hsllib`. Returns 0 on success, -1 if the library or
+ * one of the routines cannot be loaded.
+ */
+int ma97_cache_init(const char *hsllib)
+{
+    void *handle = dlopen(hsllib, RTLD_NOW | RTLD_LOCAL);
+    if (handle == NULL) return -1;
+    hsl.default_control = (default_control_t)dlsym(handle, "ma97_default_control_d");
+    hsl.analyse = (analyse_t)dlsym(handle, "ma97_analyse_d");
+    hsl.factor = (factor_t)dlsym(handle, "ma97_factor_d");
+    hsl.factor_solve = (factor_solve_t)dlsym(handle, "ma97_factor_solve_d");
+    hsl.solve = (solve_t)dlsym(handle, "ma97_solve_d");
+    hsl.free_akeep = (free_t)dlsym(handle, "ma97_free_akeep_d");
+    hsl.free_fkeep = (free_t)dlsym(handle, "ma97_free_fkeep_d");
+    hsl.finalise = (finalise_t)dlsym(handle, "ma97_finalise_d");
+    if (!hsl.default_control || !hsl.analyse || !hsl.factor || !hsl.factor_solve || !hsl.solve ||
+        !hsl.free_akeep || !hsl.free_fkeep || !hsl.finalise)
+        return -1;
+    return 0;
+}
+
+/* Parallel thresholds of the later factorizations and solves (a negative value keeps Ipopt's) */
+void ma97_cache_set_thresholds(long new_factor_min, long new_solve_min)
+{
+    factor_min = new_factor_min;
+    solve_min = new_solve_min;
+}
+
+/* Controls of a factorization or solve with the threshold overrides */
+static const struct ma97_control_d *with_thresholds(const struct ma97_control_d *control,
+                                                   struct ma97_control_d *copy)
+{
+    if (factor_min < 0 && solve_min < 0) return control;
+    *copy = *control;
+    if (factor_min >= 0) copy->factor_min = factor_min;
+    if (solve_min >= 0) copy->solve_min = solve_min;
+    return copy;
+}
+
+/* Reuse counters and number of cached analyses */
+void ma97_cache_stats(long *num_hits, long *num_misses, int *num_entries)
+{
+    pthread_mutex_lock(&lock);
+    *num_hits = hits;
+    *num_misses = misses;
+    *num_entries = 0;
+    for (int k = 0; k < MA97_CACHE_SIZE; k++)
+        if (cache[k].akeep != NULL) (*num_entries)++;
+    pthread_mutex_unlock(&lock);
+}
+
+/* Free the cached analyses that no solver holds */
+void ma97_cache_clear(void)
+{
+    pthread_mutex_lock(&lock);
+    for (int k = 0; k < MA97_CACHE_SIZE; k++)
+        if (cache[k].akeep != NULL && cache[k].in_use == 0) free_entry(&cache[k]);
+    pthread_mutex_unlock(&lock);
+}
+
+/* ---------------- MA97 entry points loaded by Ipopt ---------------- */
+
+void ma97_default_control_d(struct ma97_control_d *control)
+{
+    hsl.default_control(control);
+}
+
+void ma97_analyse_d(int check, int n, const int ptr[], const int row[], double val[], void **akeep,
+                    const struct ma97_control_d *control, struct ma97_info_d *info, int order[])
+{
+    /* Matching-based orderings read the values and user orderings read `order`: not cached */
+    if (val != NULL || order != NULL) {
+        hsl.analyse(check, n, ptr, row, val, akeep, control, info, order);
+        return;
+    }
+
+    int base = control->f_arrays ? 1 : 0;
+    int nz = ptr[n] - base;
+    int key[5] = {n, check, control->f_arrays, control->ordering, control->nemin};
+    uint64_t hash = pattern_hash(n, nz, ptr, row, key, 5);
+
+    pthread_mutex_lock(&lock);
+    clock_ticks++;
+    for (int k = 0; k < MA97_CACHE_SIZE; k++) {
+        struct entry *e = &cache[k];
+        if (e->akeep != NULL && e->hash == hash && e->n == n && e->check == check &&
+            e->f_arrays == control->f_arrays && e->ordering == control->ordering &&
+            e->nemin == control->nemin && e->ptr[n] == ptr[n] &&
+            memcmp(e->ptr, ptr, (size_t)(n + 1) * sizeof(int)) == 0 &&
+            memcmp(e->row, row, (size_t)nz * sizeof(int)) == 0) {
+            /* Release the analysis the solver may still hold before handing out the cached one */
+            if (*akeep != e->akeep) {
+                struct entry *held = *akeep != NULL ? find_entry(*akeep) : NULL;
+                if (held != NULL) held->in_use--;
+                else if (*akeep != NULL) hsl.free_akeep(akeep);
+                *akeep = e->akeep;
+                e->in_use++;
+            }
+            *info = e->info;
+            e->last_use = clock_ticks;
+            hits++;
+            pthread_mutex_unlock(&lock);
+            return;
+        }
+    }
+    misses++;
+
+    /* A held cached analysis is replaced: release it instead of letting MA97 free it */
+    struct entry *held = *akeep != NULL ? find_entry(*akeep) : NULL;
+    if (held != NULL) {
+        held->in_use--;
+        *akeep = NULL;
+    }
+    pthread_mutex_unlock(&lock);
+
+    hsl.analyse(check, n, ptr, row, val, akeep, control, info, order);
+    if (info->flag < 0) return;
+
+    pthread_mutex_lock(&lock);
+    struct entry *e = free_slot();
+    if (e != NULL) {
+        e->ptr = malloc((size_t)(n + 1) * sizeof(int));
+        e->row = malloc((size_t)(nz > 0 ? nz : 1) * sizeof(int));
+        if (e->ptr == NULL || e->row == NULL) {
+            free(e->ptr);
+            free(e->row);
+            e->ptr = e->row = NULL;
+        } else {
+            memcpy(e->ptr, ptr, (size_t)(n + 1) * sizeof(int));
+            memcpy(e->row, row, (size_t)nz * sizeof(int));
+            e->hash = hash;
+            e->n = n;
+            e->check = check;
+            e->f_arrays = control->f_arrays;
+            e->ordering = control->ordering;
+            e->nemin = control->nemin;
+            e->akeep = *akeep;
+            e->info = *info;
+            e->in_use = 1;
+            e->last_use = clock_ticks;
+        }
+    }
+    pthread_mutex_unlock(&lock);
+}
+
+void ma97_factor_d(int matrix_type, const int ptr[], const int row[], const double val[], void **akeep,
+                   void **fkeep, const struct ma97_control_d *control, struct ma97_info_d *info,
+                   double scale[])
+{
+    struct ma97_control_d copy;
+    hsl.factor(matrix_type, ptr, row, val, akeep, fkeep, with_thresholds(control, &copy), info, scale);
+}
+
+void ma97_factor_solve_d(int matrix_type, const int ptr[], const int row[], const double val[], int nrhs,
+                         double x[], int ldx, void **akeep, void **fkeep,
+                         const struct ma97_control_d *control, struct ma97_info_d *info, double scale[])
+{
+    struct ma97_control_d copy;
+    hsl.factor_solve(matrix_type, ptr, row, val, nrhs, x, ldx, akeep, fkeep, with_thresholds(control, &copy), info,
+                     scale);
+}
+
+void ma97_solve_d(int job, int nrhs, double x[], int ldx, void **akeep, void **fkeep,
+                  const struct ma97_control_d *control, struct ma97_info_d *info)
+{
+    struct ma97_control_d copy;
+    hsl.solve(job, nrhs, x, ldx, akeep, fkeep, with_thresholds(control, &copy), info);
+}
+
+void ma97_free_akeep_d(void **akeep)
+{
+    pthread_mutex_lock(&lock);
+    struct entry *e = *akeep != NULL ? find_entry(*akeep) : NULL;
+    if (e != NULL) {
+        e->in_use--;
+        *akeep = NULL;
+    }
+    pthread_mutex_unlock(&lock);
+    if (e == NULL) hsl.free_akeep(akeep);
+}
+
+void ma97_free_fkeep_d(void **fkeep)
+{
+    hsl.free_fkeep(fkeep);
+}
+
+void ma97_finalise_d(void **akeep, void **fkeep)
+{
+    hsl.free_fkeep(fkeep);
+    ma97_free_akeep_d(akeep);
+}
@@ -0,0 +1,56 @@
+module Autarky
+
+using JuMP, Ipopt, Gurobi
+import HSL_jll
+using YAML, CSV, DataFrames, LinearAlgebra, Statistics, Distributions
+
+include(joinpath(@__DIR__, "utils.jl"))
+using .Utils: import_time_series,
+              compute_average_typical_period,
+              cluster_representative_periods,
+              sample_efficiency_curve,
+              ensure_positive_semidefinite,
+              fuel_curve_segments,
+              lp_optimizer,
+              solver_optimizer
+# Joint chance constraint operators
+include(joinpath(@__DIR__, "jcc_operators.jl"))
+using .JCCOperators: define_distribution, shared_window_factors!, report_cache_usage, reset_cache_usage!,
+                     report_window_sharing, AccuracySchedule, accuracy_callback, verify_windows
+# Linear outer approximation of the expected shortfall penalty
+include(joinpath(@__DIR__, "shortfall_cuts.jl"))
+using .ShortfallCuts: ShortfallTerm, add_shortfall_cuts!, refine_shortfall_cuts!, set_shortfall_cost!
+# Reuse of the MA97 symbolic analyses across Ipopt solves
+include(joinpath(@__DIR__, "ma97_cache.jl"))
+using .MA97Cache: ma97_cache_available, init_ma97_cache, set_ma97_thresholds, report_ma97_cache, clear_ma97_cache
+
+# PVGIS downloads (both files define `build_pvgis_url` and `download_pvgis_data`)
+module SolarPVGIS
+include(joinpath(@__DIR__, "solar_pvgis.jl"))
+end
+module WindPVGIS
+include(joinpath(@__DIR__, "wind_pvgis.jl"))
+end
+
+include(joinpath(@__DIR__, "problem.jl"))
+include(joinpath(@__DIR__, "formulations.jl"))
+include(joinpath(@__DIR__, "scaling.jl"))
+include(joinpath(@__DIR__, "build.jl"))
+include(joinpath(@__DIR__, "linear_solver.jl"))
+include(joinpath(@__DIR__, "kkt_analysis.jl"))
+include(joinpath(@__DIR__, "solve.jl"))
+include(joinpath(@__DIR__, "display_results.jl"))
+include(joinpath(@__DIR__, "sweep.jl"))
+include(joinpath(@__DIR__, "continuation.jl"))
+include(joinpath(@__DIR__, "pipeline.jl"))
+
+export AutarkyProblem, load_problem,
+       Formulation, UncertainFormulation, Deterministic, ExpectedValues, ICC, JCC, horizon,
+       build_model, solve_model!, display_results,
+       SweepSettings, sweep_model!, write_sweep_to_csv,
+       ContinuationSettings, solve_continuation!,
+       PipelineSettings, warm_start_from_icc!, transfer_solution!,
+       PreflightSettings, analyse_kkt, write_kkt_analysis_to_csv,
+       objective_scale, unscaled_dual
+
+end # module Autarky
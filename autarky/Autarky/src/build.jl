@@ -0,0 +1,745 @@
+# ========================
+# MODEL BUILD
+# ========================
+
+"""
+Build the sizing and dispatch model of a problem in a given formulation.
+
+All variables, constraints and cost expressions are registered in the model under the names used by
+the result writers (`model[:NPC]`, `model[:battery_reserve]`, ...). Build data needed by the solve
+(expected shortfall cut terms, JCC windows) is kept in `model.ext`.
+
+# Arguments:
+- `problem::AutarkyProblem`: The project data.
+- `formulation::Formulation`: `Deterministic()`, `ExpectedValues(problem)`, `ICC(problem)` or `JCC(problem)`.
+
+# Returns:
+- `model::Model`: The JuMP model, without optimizer.
+"""
+function build_model(problem::AutarkyProblem, formulation::Formulation)
+    println("\nInitializing the optimization model...")
+    model = Model()
+    T = horizon(problem, formulation)
+
+    add_variables!(model, problem, formulation, T)
+    println("Variables added successfully to the model.")
+
+    add_energy_balance!(model, problem, formulation, T)
+    add_operation_constraints!(model, problem, formulation, T)
+    add_chance_constraints!(model, problem, formulation, T)
+    add_expected_shortfall!(model, problem, formulation, T)
+    println("Operation Constraints added successfully to the model.")
+
+    add_costs!(model, problem, formulation, T)
+    println("Cost Expressions added successfully to the model.")
+
+    add_optimization_constraints!(model, problem, formulation, T)
+    println("Optimization constraints added successfully to the model.")
+
+    # Objective Function: Minimization of NPC
+    @objective(model, Min, model[:NPC])
+
+    # Objective and row scaling (`scaling_settings`)
+    scale_model!(model, problem, ScalingSettings(problem.parameters))
+
+    println("Model initialized successfully")
+    return model
+end
+
+# ========================
+# VARIABLES DEFINITION
+# ========================
+
+function add_variables!(model::Model, problem::AutarkyProblem, formulation::Formulation, T::Int)
+    S = problem.S
+    reserves = has_reserves(formulation)
+
+    # Solar PV variables
+    if problem.solar.enabled
+        # Sizing
+        if problem.solar.allow_units
+            @variable(model, solar_units >= 0, integer=true, base_name="Solar_Units") # [units of nominal capacity]
+        else
+            @variable(model, solar_units >= 0, base_name="Solar_Units") # [units of nominal capacity]
+        end
+        # Operation
+        @variable(model, solar_production[t=1:T, s=1:S] >= 0, base_name="Solar_Production") # [kWh]
+    end
+
+    # Wind Turbine variables
+    if problem.wind.enabled
+        # Sizing
+        if problem.wind.allow_units
+            @variable(model, wind_units >= 0, integer=true, base_name="Wind_Units") # [units of nominal capacity]
+        else
+            @variable(model, wind_units >= 0, base_name="Wind_Units") # [units of nominal capacity]
+        end
+        # Operation
+        @variable(model, wind_production[t=1:T, s=1:S] >= 0, base_name="Wind_Production") # [kWh]
+    end
+
+    # Battery variables
+    if problem.battery.enabled
+        # Sizing
+        if problem.battery.allow_units
+            @variable(model, battery_units >= 0, integer=true, base_name="Battery_Units") # [units of nominal capacity]
+        else
+            @variable(model, battery_units >= 0, base_name="Battery_Units") # [units of nominal capacity]
+        end
+        # Operation
+        @variable(model, battery_charge[t=1:T, s=1:S] >= 0, base_name="Battery_Charge") # [kWh]
+        @variable(model, battery_discharge[t=1:T, s=1:S] >= 0, base_name="Battery_Discharge") # [kWh]
+        @variable(model, SOC[t=1:T, s=1:S], base_name="State_of_Charge") # [kWh]
+        if reserves
+            # Reserves to account for outages
+            @variable(model, battery_reserve[t=1:T, s=1:S] >= 0, base_name="Battery_Reserve") # [kWh]
+        end
+    end
+
+    # Backup Generator variables
+    if problem.generator.enabled
+        # Sizing
+        if problem.generator.allow_units
+            @variable(model, generator_units >= 0, integer=true, base_name="Generator_Units") # [units of nominal capacity]
+        else
+            @variable(model, generator_units >= 0, base_name="Generator_Units") # [units of nominal capacity]
+        end
+        # Operation
+        @variable(model, generator_production[t=1:T, s=1:S] >= 0, base_name="Generator_Production") # [kWh]
+        if reserves
+            # Reserves to account for outages
+            @variable(model, generator_reserve[t=1:T, s=1:S] >= 0, base_name="Generator_Reserve") # [kWh]
+        end
+        if problem.generator.allow_partial_load
+            @variable(model, generator_fuel_consumption[t=1:T, s=1:S] >= 0, base_name="Generator_Fuel_Consumption")  # [liters/hour]
+            if reserves
+                @variable(model, generator_fuel_reserve[t=1:T, s=1:S] >= 0, base_name="Generator_Fuel_Reserve")  # [liters/hour]
+            end
+        end
+    end
+
+    # Lost Load variable (deterministic formulation)
+    if has_lost_load(problem, formulation)
+        @variable(model, lost_load[t=1:T, s=1:S] >= 0, base_name="Lost_Load") # [kWh]
+    end
+
+    # Grid Connection variables
+    if problem.grid.allow_connection
+        @variable(model, grid_import[t=1:T, s=1:S] >= 0, base_name="Grid_Import") # [kWh]
+        if problem.grid.allow_export
+            @variable(model, grid_export[t=1:T, s=1:S] >= 0, base_name="Grid_Export") # [kWh]
+        end
+    end
+
+    # Uncertainty
+    if formulation isa UncertainFormulation
+        @variable(model, expected_shortfall[t=1:T, s=1:S] >= 0, base_name="Expected_Shortfall") # [kWh]
+    end
+    return model
+end
+
+has_lost_load(problem::AutarkyProblem, ::Formulation) = false
+has_lost_load(problem::AutarkyProblem, ::Deterministic) = problem.max_lost_load_share > 0
+
+# ========================
+# ENERGY BALANCE CONSTRAINT
+# ========================
+
+"""
+Net supply of time step t and season s: production and battery discharge minus battery charge,
+grid import minus grid export.
+"""
+function net_supply(model::Model, problem::AutarkyProblem, t::Int, s::Int)
+    supply = AffExpr()
+    if problem.solar.enabled
+        supply += model[:solar_production][t, s]
+    end
+    if problem.wind.enabled
+        supply += model[:wind_production][t, s]
+    end
+    if problem.battery.enabled
+        supply += model[:battery_discharge][t, s] - model[:battery_charge][t, s]
+    end
+    if problem.generator.enabled
+        supply += model[:generator_production][t, s]
+    end
+    if problem.grid.allow_connection
+        supply += model[:grid_import][t, s]
+        if problem.grid.allow_export
+            supply -= model[:grid_export][t, s]
+        end
+    end
+    return supply
+end
+
+function add_energy_balance!(model::Model, problem::AutarkyProblem, formulation::Deterministic, T::Int)
+    for s in 1:problem.S, t in 1:T
+        supply = net_supply(model, problem, t, s)
+        if has_lost_load(problem, formulation)
+            supply += model[:lost_load][t, s]
+        end
+        @constraint(model, supply == problem.load[t, s])
+    end
+    println("Energy Balance Constraint added successfully.")
+end
+
+function add_energy_balance!(model::Model, problem::AutarkyProblem, ::ExpectedValues, T::Int)
+    for s in 1:problem.S, t in 1:T
+        @constraint(model, net_supply(model, problem, t, s) - problem.load[t, s] >= 0)
+    end
+    println("Energy Balance Constraint added successfully.")
+end
+
+function add_energy_balance!(model::Model, problem::AutarkyProblem, ::ICC, T::Int)
+    # Quantile of the unbiased normal forecast error at the islanding probability
+    # (registered so that parametric re-solves can move the right-hand sides, see `update_model!`)
+    z = quantile(Normal(), problem.uncertainty.islanding_probability)
+    @constraint(model, energy_balance[t=1:T, s=1:problem.S],
+                net_supply(model, problem, t, s) - problem.load[t, s] >= z * problem.uncertainty.errors_stddev[s][t])
+    println("Energy Balance Constraint added successfully.")
+end
+
+# The JCC formulation covers the load through the reserve mismatch and the expected shortfall only
+add_energy_balance!(model::Model, problem::AutarkyProblem, ::JCC, T::Int) = nothing
+
+# ===============================
+# OPERATION CONSTRAINTS
+# ===============================
+
+function add_operation_constraints!(model::Model, problem::AutarkyProblem, formulation::Formulation, T::Int)
+    S = problem.S
+    Δt = problem.Δt
+    reserves = has_reserves(formulation)
+
+    # Technology-specific constraints
+    if problem.solar.enabled
+        solar_units = model[:solar_units]
+        solar_production = model[:solar_production]
+        @constraint(model, solar_production_limit[t=1:T, s=1:S], solar_production[t,s] <= solar_units * problem.solar_unit_production[t,s])
+    end
+
+    if problem.wind.enabled
+        wind_units = model[:wind_units]
+        wind_production = model[:wind_production]
+        @constraint(model, wind_production_limit[t=1:T, s=1:S], wind_production[t,s] <= wind_units * problem.wind_power[t,s])
+    end
+
+    if problem.battery.enabled
+        battery = problem.battery
+        battery_units = model[:battery_units]
+        battery_charge = model[:battery_charge]
+        battery_discharge = model[:battery_discharge]
+        SOC = model[:SOC]
+        battery_capacity = battery_units * battery.nominal_capacity
+
+        @constraint(model, battery_charge_limit[t=1:T, s=1:S], battery_charge[t,s] <= (battery_capacity / battery.t_charge) * Δt)
+        if reserves
+            battery_reserve = model[:battery_reserve]
+            @constraint(model, battery_discharge_limit[t=1:T, s=1:S], battery_discharge[t,s] + battery_reserve[t,s] <= (battery_capacity / battery.t_discharge) * Δt)
+        else
+            @constraint(model, battery_discharge_limit[t=1:T, s=1:S], battery_discharge[t,s] <= (battery_capacity / battery.t_discharge) * Δt)
+        end
+
+        # Battery SOC constraints
+        @constraint(model, soc_lower_limit[t=1:T, s=1:S], SOC[t,s] >= battery.SOC_min * battery_capacity)
+        @constraint(model, soc_upper_limit[t=1:T, s=1:S], SOC[t,s] <= battery.SOC_max * battery_capacity)
+        @constraint(model, soc_initial[s=1:S], SOC[1, s] == (battery.SOC_0 * battery_capacity) + (battery_charge[1,s] * battery.η_charge - battery_discharge[1,s] * battery.η_discharge))
+        @constraint(model, soc_balance[t=2:T, s=1:S], SOC[t,s] == SOC[t-1,s] + (battery_charge[t,s] * battery.η_charge - battery_discharge[t,s] * battery.η_discharge))
+        @constraint(model, soc_final[s=1:S], SOC[T, s] == battery.SOC_0 * battery_capacity)  # End-of-horizon SOC continuity
+
+        if reserves
+            add_soc_under_reserves!(model, problem, T)
+        end
+    end
+
+    # Generator Capacity Limit (if applicable)
+    if problem.generator.enabled
+        generator = problem.generator
+        generator_units = model[:generator_units]
+        generator_production = model[:generator_production]
+        if reserves
+            generator_reserve = model[:generator_reserve]
+            @constraint(model, generator_capacity_limit[t=1:T, s=1:S], generator_production[t,s] + generator_reserve[t,s] <= generator_units * generator.nominal_capacity * Δt)
+        else
+            @constraint(model, generator_capacity_limit[t=1:T, s=1:S], generator_production[t,s] <= generator_units * generator.nominal_capacity * Δt)
+        end
+
+        # Partial Load constraints (fuel consumtpion piecewise linear approximation)
+        if generator.allow_partial_load
+            add_fuel_curve!(model, problem, formulation, T)
+        end
+    end
+
+    if problem.grid.allow_connection
+        grid_import = model[:grid_import]
+        @constraint(model, grid_import_limit[t=1:T, s=1:S], grid_import[t,s] <= problem.grid_availability[t,s] * (problem.grid.max_line_capacity * Δt))
+        if problem.grid.allow_export
+            grid_export = model[:grid_export]
+            @constraint(model, grid_export_limit[t=1:T, s=1:S], grid_export[t,s] <= problem.grid_availability[t,s] * (problem.grid.max_line_capacity * Δt))
+        end
+    end
+    return model
+end
+
+"""
+Battery SOC under reserves (during outages): the SOC at t covers the reserves of every outage window ending at t.
+"""
+function add_soc_under_reserves!(model::Model, problem::AutarkyProblem, T::Int)
+    S = problem.S
+    D = problem.uncertainty.outage_duration
+    SOC_min = problem.battery.SOC_min
+    battery_nominal_capacity = problem.battery.nominal_capacity
+    η_discharge = problem.battery.η_discharge
+    SOC = model[:SOC]
+    battery_reserve = model[:battery_reserve]
+
+    if problem.uncertainty.reserve_formulation == "explicit"
+        # One row per outage window ending before t: O(S·T²) rows
+        for s in 1:S
+            for t in 1:T
+                for τ in 1:max(t-D, 1)
+                    @constraint(model, SOC_min*battery_nominal_capacity <= SOC[t,s] - sum(battery_reserve[t_out,s]*η_discharge for t_out in τ:min(τ+D, t)))
+                end
+            end
+        end
+    else
+        # Rolling formulation with O(S·T) rows: window sums W[τ] = Σ reserve[τ:τ+D] by recursion, and their
+        # running maximum M[τ] ≥ W[1..τ], so that a single row bounds SOC at t = τ + D by the largest window
+        n_windows = max(T - D, 0)
+        @variable(model, reserve_window_sum[τ=1:n_windows, s=1:S], base_name="Reserve_Window_Sum") # [kWh]
+        @variable(model, reserve_window_max[τ=1:n_windows, s=1:S], base_name="Reserve_Window_Max") # [kWh]
+        for s in 1:S
+            # While t ≤ D the only outage window starts at the first time step and covers 1:t
+            for t in 1:min(D, T)
+                @constraint(model, SOC_min*battery_nominal_capacity <= SOC[t,s] - η_discharge * sum(battery_reserve[t_out,s] for t_out in 1:t))
+            end
+            for τ in 1:n_windows
+                if τ == 1
+                    @constraint(model, reserve_window_sum[τ,s] == sum(battery_reserve[t_out,s] for t_out in 1:D+1))
+                    @constraint(model, reserve_window_max[τ,s] >= reserve_window_sum[τ,s])
+                else
+                    @constraint(model, reserve_window_sum[τ,s] == reserve_window_sum[τ-1,s] + battery_reserve[τ+D,s] - battery_reserve[τ-1,s])
+                    @constraint(model, reserve_window_max[τ,s] >= reserve_window_max[τ-1,s])
+                    @constraint(model, reserve_window_max[τ,s] >= reserve_window_sum[τ,s])
+                end
+                @constraint(model, SOC_min*battery_nominal_capacity <= SOC[τ+D,s] - η_discharge * reserve_window_max[τ,s])
+            end
+        end
+    end
+    return model
+end
+
+"""
+Fuel consumption of the generator (and of its reserves) above the sampled efficiency curve.
+"""
+function add_fuel_curve!(model::Model, problem::AutarkyProblem, formulation::Formulation, T::Int)
+    S = problem.S
+    generator = problem.generator
+    reserves = has_reserves(formulation)
+    generator_units = model[:generator_units]
+    generator_production = model[:generator_production]
+    generator_fuel_consumption = model[:generator_fuel_consumption]
+
+    # Compute fuel consumption points
+    relative_output = generator.sampled_relative_output
+    fuel_power_points = [relative_output[i] * generator.nominal_capacity for i in eachindex(relative_output)]
+    fuel_consumption_samples = [(relative_output[i] * generator.nominal_capacity) / (generator.sampled_efficiency[i] * generator.fuel_lhv) for i in eachindex(relative_output)]
+
+    if generator.fuel_curve == "samples"
+        # Add piecewise fuel consumption linear constraints
+        for s in 1:S
+            for t in 1:T
+                for i in 1:(length(relative_output) - 1)
+                    slope = (fuel_consumption_samples[i+1] - fuel_consumption_samples[i]) / (fuel_power_points[i+1] - fuel_power_points[i])
+
+                    @constraint(model, generator_fuel_consumption[t,s] >= slope * (generator_production[t,s] - fuel_power_points[i] * generator_units) +
+                                                            fuel_consumption_samples[i] * generator_units)
+                    if reserves
+                        @constraint(model, model[:generator_fuel_reserve][t,s] >= slope * (model[:generator_reserve][t,s] - fuel_power_points[i] * generator_units) +
+                                                                fuel_consumption_samples[i] * generator_units)
+                    end
+                end
+            end
+        end
+    else
+        # Epigraph of the lower convex envelope: one segment table shared by production and reserve fuel
+        fuel_slopes, fuel_intercepts = fuel_curve_segments(fuel_power_points, fuel_consumption_samples)
+        println("Fuel curve: $(length(fuel_slopes)) of $(length(fuel_power_points) - 1) sampled segments support the lower convex envelope.")
+        @constraint(model, fuel_curve_production[t=1:T, s=1:S, k=eachindex(fuel_slopes)],
+                    generator_fuel_consumption[t,s] >= fuel_slopes[k] * generator_production[t,s] + fuel_intercepts[k] * generator_units)
+        if reserves
+            generator_reserve = model[:generator_reserve]
+            generator_fuel_reserve = model[:generator_fuel_reserve]
+            @constraint(model, fuel_curve_reserve[t=1:T, s=1:S, k=eachindex(fuel_slopes)],
+                        generator_fuel_reserve[t,s] >= fuel_slopes[k] * generator_reserve[t,s] + fuel_intercepts[k] * generator_units)
+        end
+    end
+    return model
+end
+
+# --------------------------------------
+# Build Joint Chance Constraints for Outages
+# --------------------------------------
+
+"""
+Build data of the JCC windows, kept in `model.ext[:jcc]` for the solve.
+
+# Fields:
+- `store::JCCOperators.WindowFactorStore`: Shared window factorizations and integration rules.
+- `caches::Vector{JCCOperators.WindowCache}`: Evaluation cache of each window.
+- `windows::Vector{JCCOperators.WindowFactors}`: Factorization of each window.
+- `window_starts::Vector{Tuple{Int, Int}}`: (τ, s) of each window.
+"""
+struct JCCWindows
+    store::JCCOperators.WindowFactorStore
+    caches::Vector{JCCOperators.WindowCache}
+    windows::Vector{JCCOperators.WindowFactors}
+    window_starts::Vector{Tuple{Int, Int}}
+end
+
+"""
+Supply held against an outage at (t, s): battery and generator reserves, grid import minus grid export.
+"""
+function reserve_supply(model::Model, problem::AutarkyProblem, t::Int, s::Int)
+    reserve_expr = AffExpr()
+    if problem.battery.enabled
+        reserve_expr += model[:battery_reserve][t, s]
+    end
+    if problem.generator.enabled
+        reserve_expr += model[:generator_reserve][t, s]
+    end
+    if problem.grid.allow_connection
+        reserve_expr += model[:grid_import][t, s]
+        if problem.grid.allow_export
+            reserve_expr -= model[:grid_export][t, s]
+        end
+    end
+    return reserve_expr
+end
+
+add_chance_constraints!(model::Model, problem::AutarkyProblem, ::Formulation, T::Int) = nothing
+
+function add_chance_constraints!(model::Model, problem::AutarkyProblem, formulation::JCC, T::Int)
+    S = problem.S
+    D = problem.uncertainty.outage_duration
+    settings = formulation.settings
+
+    # Storage for reserve mismatch variables for each season
+    @variable(model, reserve_mismatch[1:T, 1:S], base_name="Reserve_Mismatch") # [kWh]
+
+    # Enforce reserve mismatch (positive means supply >= demand)
+    @constraint(model, reserve_mismatch_definition[t=1:T, s=1:S],
+                reserve_mismatch[t, s] == reserve_supply(model, problem, t, s) - problem.load[t, s])
+
+    # Register and add JCC constraints over outage windows
+    # Rules hold enough points for every stage of the adaptive schedule and for the final check
+    capacity = maximum([settings.samples; settings.adaptive ? settings.adaptive_samples : Int[]; settings.verify_samples])
+    store = JCCOperators.WindowFactorStore(integrator=settings.integrator, samples=settings.samples, capacity=capacity,
+                                           shifts=settings.shifts, seed=settings.seed)
+    jcc = JCCWindows(store, JCCOperators.WindowCache[], JCCOperators.WindowFactors[], Tuple{Int, Int}[])
+    # Islanding probability as a nonlinear parameter shared by every window
+    islanding_probability = add_nonlinear_parameter(model, problem.uncertainty.islanding_probability)
+    model.ext[:islanding_probability] = islanding_probability
+    for s in 1:S
+        σ = problem.uncertainty.errors_stddev[s]
+        Σ = problem.uncertainty.errors_covariance[s]
+        for τ in 1:(T - D)  # τ must allow the outage window to fit inside horizon
+            # Windows with identical error statistics share one factorization (zero-mean errors)
+            window = τ:τ+D
+            factors = shared_window_factors!(store, zeros(length(window)), σ[window], Σ[window, window])
+
+            # Function, gradient and Hessian share one evaluation cache per window
+            f_jcc, ∇f_jcc, ∇²f_jcc, cache = define_distribution(factors; threaded=settings.threaded)
+            push!(jcc.caches, cache)
+            push!(jcc.windows, factors)
+            push!(jcc.window_starts, (τ, s))
+
+            # Register function and derivatives (one argument per time step of the outage window)
+            operator = Symbol("mvncdf_$(τ)_$(s)")
+            if settings.hessian == "exact"
+                register(model, operator, D + 1, f_jcc, ∇f_jcc, ∇²f_jcc)
+            else
+                register(model, operator, D + 1, f_jcc, ∇f_jcc)
+            end
+
+            # Add nonlinear constraint (joint chance constraint) on the window variables only
+            add_nonlinear_constraint(model, :($(operator)($(reserve_mismatch[window, s]...)) >= $(islanding_probability)))
+        end
+    end
+
+    report_window_sharing(store)
+    if settings.threaded
+        println("Threaded JCC evaluation on $(Threads.nthreads()) threads.")
+    end
+    println("Joint Chance Constraints (JCC) added successfully.")
+    model.ext[:jcc] = jcc
+    return model
+end
+
+# --------------------------------------
+# Expected Shortfall Energy Mismatch
+# --------------------------------------
+
+# Standard normal loss function g(z) = φ(z) + z Φ(z) and its first and second derivatives.
+# The expected penalty of a mismatch y with cost c and error standard deviation σ is c σ g(y/σ),
+# so one registered operator serves every (t, s).
+shortfall(z) = pdf(Normal(), z) + z * cdf(Normal(), z)
+∇shortfall(z) = cdf(Normal(), z)
+∇²shortfall(z) = pdf(Normal(), z)
+
+shortfall_formulation(formulation::Union{ExpectedValues, ICC}) = formulation.shortfall.formulation
+shortfall_formulation(::JCC) = "nonlinear"
+
+add_expected_shortfall!(model::Model, problem::AutarkyProblem, ::Formulation, T::Int) = nothing
+
+function add_expected_shortfall!(model::Model, problem::AutarkyProblem, formulation::UncertainFormulation, T::Int)
+    S = problem.S
+    nonlinear = shortfall_formulation(formulation) == "nonlinear"
+    expected_shortfall = model[:expected_shortfall]
+
+    if nonlinear
+        register(model, :shortfall, 1, shortfall, ∇shortfall, ∇²shortfall)
+        # Exchange cost as a nonlinear parameter shared by every penalty term
+        exchange_cost_parameter = add_nonlinear_parameter(model, problem.grid.exchange_cost)
+        model.ext[:grid_exchange_cost] = exchange_cost_parameter
+    end
+
+    # Terms of the linear outer approximation (tangent_cuts formulation)
+    shortfall_terms = ShortfallTerm[]
+
+    # Storage container for mismatch variables
+    @variable(model, y[1:T, 1:S], base_name="Mismatch_Energy") # [kWh]
+    # Mismatch between the load and the net supply
+    @constraint(model, mismatch_definition[t=1:T, s=1:S], y[t, s] == problem.load[t, s] - net_supply(model, problem, t, s))
+    # Nonlinear penalty rows of each (t, s), kept in `model.ext[:shortfall_rows]` (see `transfer_solution!`)
+    shortfall_rows = Matrix{NonlinearConstraintRef}(undef, T, S)
+
+    for s in 1:S
+        for t in 1:T
+            # Expected shortfall penalty through the shared operator
+            σ_ts = problem.uncertainty.errors_stddev[s][t]  # Standard deviation for time t, season s
+
+            if nonlinear
+                shortfall_rows[t, s] = add_nonlinear_constraint(model, :($σ_ts * ($(problem.grid_cost[t, s]) + $(exchange_cost_parameter)) * shortfall($(y[t, s]) / $σ_ts) == $(expected_shortfall[t,s])))
+            else
+                c = problem.grid_cost[t, s] + problem.grid.exchange_cost  # Cost for time t, season s
+                push!(shortfall_terms, ShortfallTerm(expected_shortfall[t, s], y[t, s], c, σ_ts))
+            end
+        end
+    end
+
+    if nonlinear
+        model.ext[:shortfall_rows] = shortfall_rows
+    else
+        num_shortfall_cuts = add_shortfall_cuts!(model, shortfall_terms, formulation.shortfall.cuts)
+        println("Expected shortfall: outer approximation with $num_shortfall_cuts linear cuts.")
+        model.ext[:shortfall_terms] = shortfall_terms
+    end
+    if formulation isa ICC
+        println("Individual Chance Constraints (ICC) added successfully.")
+    end
+    return model
+end
+
+# ========================
+# COST EXPRESSIONS
+# ========================
+
+function add_costs!(model::Model, problem::AutarkyProblem, formulation::Formulation, T::Int)
+    project_lifetime = problem.project_lifetime
+    discount_factor = problem.discount_factor
+
+    # Initialize cost components
+    CAPEX_expr = AffExpr()
+    Replacement_Cost_npv_expr = AffExpr()
+    Subsidies_expr = AffExpr()
+    OPEX_fixed_expr = AffExpr()
+    Salvage_expr = AffExpr()
+
+    # Add technology costs conditionally
+    for (technology, units, subsidy_share) in ((problem.solar, :solar_units, problem.solar.subsidy_share),
+                                               (problem.wind, :wind_units, problem.wind.subsidy_share),
+                                               (problem.battery, :battery_units, 0.0),
+                                               (problem.generator, :generator_units, 0.0))
+        technology.enabled || continue
+        investment = (model[units] * technology.nominal_capacity) * technology.capex
+        CAPEX_expr += investment
+        Replacement_Cost_npv_expr += sum((investment * discount_factor[y]) for y in replacement_years(technology.lifetime, project_lifetime); init=AffExpr())
+        if subsidy_share > 0
+            Subsidies_expr += investment * subsidy_share
+        end
+        OPEX_fixed_expr += investment * technology.opex
+        Salvage_expr += investment * salvage_fraction(technology.lifetime, project_lifetime)
+    end
+
+    # CAPEX, Subsidies, Fixed OPEX, Salvage NPV
+    @expression(model, CAPEX, CAPEX_expr)
+    @expression(model, Replacement_Cost_npv, Replacement_Cost_npv_expr)
+    @expression(model, Subsidies, Subsidies_expr)
+    @expression(model, OPEX_fixed, OPEX_fixed_expr)
+    @expression(model, Salvage_npv, Salvage_expr * discount_factor[project_lifetime])
+
+    # Annual operation cost, then OPEX Net Present Value (across project lifetime)
+    annual_opex = add_operation_costs!(model, problem, formulation, T)
+    @expression(model, OPEX_npv, sum((annual_opex + OPEX_fixed) * discount_factor[y] for y in 1:project_lifetime))
+
+    # Total Net Present Cost (NPC)
+    @expression(model, NPC, (CAPEX - Subsidies) + Replacement_Cost_npv + OPEX_npv - Salvage_npv)
+    return model
+end
+
+"""
+Fuel cost of the generator production at (t, s).
+"""
+function fuel_cost_expr(model::Model, problem::AutarkyProblem, t::Int, s::Int)
+    generator = problem.generator
+    if generator.allow_partial_load
+        # Use fuel consumption for fuel cost calculation
+        return model[:generator_fuel_consumption][t, s] * generator.fuel_cost
+    end
+    # Use generator production for fuel cost calculation
+    return (model[:generator_production][t, s] / generator.fuel_lhv) * generator.fuel_cost
+end
+
+"""
+Seasonally weighted annual sum of `term(t, s)`.
+"""
+annual_sum(problem::AutarkyProblem, term, T::Int) =
+    sum(problem.season_weights[s] * sum(term(t, s) for t in 1:T) for s in 1:problem.S)
+
+function add_operation_costs!(model::Model, problem::AutarkyProblem, ::Deterministic, T::Int)
+    S = problem.S
+    OPEX_variable_expr = [AffExpr() for t in 1:T, s in 1:S]
+
+    # Grid-related operational costs
+    if problem.grid.allow_connection
+        for s in 1:S
+            for t in 1:T
+                OPEX_variable_expr[t, s] += model[:grid_import][t, s] * problem.grid_cost[t, s]
+                if problem.grid.allow_export
+                    OPEX_variable_expr[t, s] -= model[:grid_export][t, s] * problem.grid_price[t, s]
+                end
+            end
+        end
+    end
+
+    # Generator fuel cost (variable OPEX)
+    if problem.generator.enabled
+        for s in 1:S
+            for t in 1:T
+                OPEX_variable_expr[t, s] += fuel_cost_expr(model, problem, t, s)
+            end
+        end
+    end
+
+    @expression(model, OPEX_variable[t=1:T, s=1:S], OPEX_variable_expr[t,s])
+    return annual_sum(problem, (t, s) -> OPEX_variable_expr[t, s], T)
+end
+
+function add_operation_costs!(model::Model, problem::AutarkyProblem, ::UncertainFormulation, T::Int)
+    S = problem.S
+    grid = problem.grid
+    generator = problem.generator
+    expected_shortfall = model[:expected_shortfall]
+
+    # Core operational costs
+    if generator.enabled
+        @expression(model, core_operational_costs[t=1:T, s=1:S], fuel_cost_expr(model, problem, t, s))
+    else
+        # No generator installed
+        @expression(model, core_operational_costs[t=1:T, s=1:S], AffExpr())
+    end
+
+    # Grid exchange and expected shortfall cost of (t, s)
+    function exchange_cost(t, s)
+        cost = expected_shortfall[t, s] * grid.exchange_cost
+        if grid.allow_connection
+            cost += model[:grid_import][t, s] * problem.grid_cost[t, s]
+            if grid.allow_export
+                cost -= model[:grid_export][t, s] * problem.grid_price[t, s]
+            end
+        end
+        return cost
+    end
+
+    # Number of outage windows τ:min(τ+outage_duration, T), τ = 1..T, that exclude each time step t:
+    # the outage and reserve costs below weight t by this count instead of summing over every window
+    D = problem.uncertainty.outage_duration
+    outage_exclusion_count = [T - min(t, D + 1) for t in 1:T]
+
+    # Define Outage Costs
+    @expression(model, outage_costs, annual_sum(problem, (t, s) -> outage_exclusion_count[t] * exchange_cost(t, s), T))
+    @expression(model, non_outage_costs, annual_sum(problem, exchange_cost, T))
+
+    # Reserve costs during outages
+    if generator.enabled
+        if generator.allow_partial_load
+            # Generator with partial load (fuel consumption available)
+            reserve_fuel = model[:generator_fuel_reserve]
+            @expression(model, reserve_costs, annual_sum(problem, (t, s) -> outage_exclusion_count[t] * (reserve_fuel[t, s] * generator.fuel_cost), T))
+        else
+            # Generator without partial load (using production and nominal efficiency)
+            generator_reserve = model[:generator_reserve]
+            @expression(model, reserve_costs, annual_sum(problem, (t, s) -> outage_exclusion_count[t] * ((generator_reserve[t, s] / generator.fuel_lhv) * generator.fuel_cost), T))
+        end
+    else
+        # No generator installed → no reserve costs
+        @expression(model, reserve_costs, AffExpr())
+    end
+
+    # Core operational costs total (fuel consumption during normal operation)
+    core_operational_costs = model[:core_operational_costs]
+    @expression(model, core_operational_costs_total, annual_sum(problem, (t, s) -> core_operational_costs[t, s], T))
+
+    # Annual OPEX (weighted for outage probability and seasonal variations)
+    outage_probability = problem.uncertainty.outage_probability
+    @expression(model, Annual_Opex,
+        core_operational_costs_total + (outage_probability / T) * (outage_costs + reserve_costs) + (1 - outage_probability) * non_outage_costs
+    )
+    return Annual_Opex
+end
+
+# ========================
+# OPTIMIZATION CONSTRAINTS
+# ========================
+
+function add_optimization_constraints!(model::Model, problem::AutarkyProblem, formulation::Formulation, T::Int)
+    S = problem.S
+
+    # Lost Load constraint
+    if has_lost_load(problem, formulation)
+        lost_load = model[:lost_load]
+        @constraint(model, annual_sum(problem, (t, s) -> lost_load[t, s], T) <= problem.max_lost_load_share * annual_sum(problem, (t, s) -> problem.load[t, s], T))
+    end
+
+    # CAPEX cap constraint
+    @constraint(model, capex_cap, model[:CAPEX] <= problem.max_capex)
+
+    # Renewable penetration constraint
+    if problem.min_res_share > 0 && (problem.solar.enabled || problem.wind.enabled)
+        # Renewable and total generation of each time step and season
+        function renewable_generation(t, s)
+            generation = AffExpr()
+            if problem.solar.enabled
+                generation += model[:solar_production][t, s]
+            end
+            if problem.wind.enabled
+                generation += model[:wind_production][t, s]
+            end
+            return generation
+        end
+        total_generation(t, s) = problem.generator.enabled ? renewable_generation(t, s) + model[:generator_production][t, s] : renewable_generation(t, s)
+
+        annual_renewable_production = annual_sum(problem, renewable_generation, T)
+        annual_total_generation = annual_sum(problem, total_generation, T)
+        @constraint(model, annual_renewable_production >= problem.min_res_share * annual_total_generation)
+    end
+
+    # Max fuel consumption constraint (annual fuel of the generator production)
+    generator = problem.generator
+    if generator.enabled && generator.fuel_consumption_limit
+        generator_production = model[:generator_production]
+        @constraint(model, annual_sum(problem, (t, s) -> generator_production[t, s] / generator.fuel_lhv, T) <= generator.max_fuel_consumption)
+    end
+    return model
+end
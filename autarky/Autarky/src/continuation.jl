@@ -0,0 +1,102 @@
+# ========================
+# JCC CONTINUATION
+# ========================
+
+"""
+Settings of the islanding probability continuation of the JCC model (`continuation_settings` of parameters.yaml).
+
+# Fields:
+- `enabled::Bool`: Reach `islanding_probability` through a sequence of increasing levels.
+- `start::Float64`: First reliability level.
+- `steps::Int`: Number of levels from `start` to `islanding_probability`, both included (at least 2 if `start` is below it).
+- `max_bisections::Int`: Step halvings allowed in total after levels that fail to converge.
+- `ipopt_warm_start_options::Dict{Any, Any}`: Ipopt options set once the first level has converged.
+"""
+struct ContinuationSettings
+    enabled::Bool
+    start::Float64
+    steps::Int
+    max_bisections::Int
+    ipopt_warm_start_options::Dict{Any, Any}
+end
+
+function ContinuationSettings(parameters::Dict)
+    continuation_settings = get(parameters, "continuation_settings", Dict())
+    return ContinuationSettings(get(continuation_settings, "enabled", false), get(continuation_settings, "start", 0.5),
+                                get(continuation_settings, "steps", 5), get(continuation_settings, "max_bisections", 4),
+                                Dict{Any, Any}(get(continuation_settings, "ipopt_warm_start_options",
+                                                   Dict("warm_start_init_point" => "yes"))))
+end
+
+"""
+Solve the JCC model at its islanding probability by continuation from a lower reliability level.
+
+The levels `start`, ..., `islanding_probability` are solved in increasing order on the same model
+(the islanding probability is a nonlinear parameter of the JCC rows), each one warm-started from the
+primal and dual solution of the last converged level. A level that fails to converge is retried
+halfway between it and the last converged level, up to `max_bisections` times in total. The first
+level starts from the start values of the model (e.g. the ICC solution).
+
+# Arguments:
+- `model::Model`: Model returned by `build_model(problem, formulation)`.
+- `problem::AutarkyProblem`: The project data (its islanding probability is the target level).
+- `formulation::JCC`: The JCC formulation the model was built with.
+- `settings::ContinuationSettings`: The continuation levels.
+
+# Returns:
+- `frontier::DataFrame`: NPC-versus-reliability frontier, one row per solve, failed levels included (see `sweep_table`).
+- `problem::AutarkyProblem`: The project data of the last solved level.
+"""
+function solve_continuation!(model::Model, problem::AutarkyProblem, formulation::JCC, settings::ContinuationSettings)
+    target = problem.uncertainty.islanding_probability
+    if !(0 < settings.start <= target) || settings.steps < 1
+        error("Invalid continuation settings: start = $(settings.start), steps = $(settings.steps). The start must lie in (0, $target] and steps must be positive.")
+    end
+    # Both ends are levels: a start below the target needs at least two
+    if settings.start < target && settings.steps < 2
+        error("Invalid continuation steps: $(settings.steps). A start ($(settings.start)) below the target islanding probability ($target) needs at least 2 steps.")
+    end
+    levels = unique(collect(range(settings.start, target; length=settings.steps)))
+    frontier = sweep_table(problem, "islanding_probability")
+
+    attach_optimizer!(model, problem, formulation)
+    start = nothing      # Solution of the last converged level
+    converged = nothing  # Last converged level
+    bisections = 0
+    k = 1
+    while k <= length(levels)
+        p = levels[k]
+        println("\n------ Continuation level $k of $(length(levels)): islanding_probability = $p ------")
+        problem = set_parameter(problem, "islanding_probability", p)
+        update_model!(model, problem, formulation, "islanding_probability")
+        if start !== nothing
+            apply_warm_start!(model, start)
+        end
+
+        status = optimize_model!(model, problem, formulation)
+        record_point!(frontier, model, p, status)
+        if is_solved_and_feasible(model; allow_almost=true)
+            if start === nothing
+                set_ipopt_options!(model, settings.ipopt_warm_start_options)
+            end
+            start = WarmStart(model, true)
+            converged = p
+            k += 1
+        elseif converged !== nothing && bisections < settings.max_bisections
+            # Retry with half the step from the last converged level
+            insert!(levels, k, (converged + p) / 2)
+            bisections += 1
+            println("Level $p did not converge ($status): retrying from $converged with half the step.")
+        else
+            println("Continuation stopped: level $p did not converge ($status).")
+            break
+        end
+    end
+
+    if converged == target
+        println("\nContinuation reached the target islanding probability $target in $(nrow(frontier)) solves.")
+    else
+        println("\nWarning: continuation did not reach the target islanding probability $target.")
+    end
+    return frontier, problem
+end
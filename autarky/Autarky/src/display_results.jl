@@ -0,0 +1,187 @@
+# ========================
+# DISPLAY RESULTS
+# ========================
+
+"""
+Print the optimization settings and the main sizing, cost and operation results of a solved model.
+
+# Arguments:
+- `model::Model`: The solved model.
+- `problem::AutarkyProblem`: The project data.
+- `formulation::Formulation`: The formulation the model was built with.
+"""
+function display_results(model::Model, problem::AutarkyProblem, formulation::Formulation)
+    T = horizon(problem, formulation)
+    S = problem.S
+    season_weights = problem.season_weights
+    currency = problem.currency
+    solar, wind, battery, generator, grid = problem.solar, problem.wind, problem.battery, problem.generator, problem.grid
+
+    println("\n------ System Optimization Settings ------")
+
+    println("\nProject Time Settings:")
+    println(" Project Time Horizon: ", problem.project_lifetime, " years")
+    println(" Number of Operation Time Steps: ", problem.operation_time_steps, " hours")
+    println(" Number of Seasons: ", problem.num_seasons)
+
+    println("\nOptimization Settings:")
+    println("  System Components: ", solar.enabled ? "Solar PV, " : "", wind.enabled ? "Wind Turbine, " : "", battery.enabled ? "Battery Bank, " : "", generator.enabled ? "Backup Generator" : "")
+    if has_lost_load(problem, formulation)
+        println("  Maximum Lost Load Share: ", problem.max_lost_load_share*100, " %")
+    end
+    println("  Minimum Renewable Penetration: ", problem.min_res_share*100, " %")
+    println("  Grid Connection: ", grid.allow_connection ? "Yes" : "No")
+    if grid.allow_connection
+        println("  Grid Export: ", grid.allow_export ? "Yes" : "No")
+    end
+
+    println("\n------ System Optimization Results ------")
+
+    println("\nSystem Sizing:")
+    if solar.enabled
+        println("  Solar Capacity: ", round(value(model[:solar_units]) * solar.nominal_capacity, digits=2), " kW")
+    end
+    if wind.enabled
+        println("  Wind Capacity: ", round(value(model[:wind_units]) * wind.nominal_capacity, digits=2), " kW")
+    end
+    if battery.enabled
+        println("  Battery Capacity: ", round(value(model[:battery_units]) * battery.nominal_capacity, digits=2), " kWh")
+    end
+    if generator.enabled
+        println("  Generator Capacity: ", round(value(model[:generator_units]) * generator.nominal_capacity, digits=2), " kW")
+    end
+
+    println("\nProject Costs:")
+    println("  Net Present Cost: ", round(value(model[:NPC]) / 1000, digits=2), " k$currency")
+    println("  Total Investment Cost: ", round(value(model[:CAPEX]) / 1000, digits=2), " k$currency")
+    println("  Total Subsidies: ", round(value(model[:Subsidies]) / 1000, digits=2), " k$currency")
+    println("  Discounted Replacement Cost: ", round(value(model[:Replacement_Cost_npv]) / 1000, digits=2), " k$currency")
+    println("  Discounted Total Operation Cost: ", round(value(model[:OPEX_npv]) / 1000, digits=2), " k$currency")
+
+    if grid.allow_connection
+        total_grid_cost = sum(season_weights[s] * (value(model[:grid_import][t, s]) * problem.grid_cost[t,s]) for t in 1:T, s in 1:S)
+        println("  Total Annual Grid Cost: ", round(total_grid_cost / 1000, digits=2), " k$currency/year")
+
+        if grid.allow_export
+            total_grid_revenue = sum(season_weights[s] * (value(model[:grid_export][t, s]) * problem.grid_price[t,s]) for t in 1:T, s in 1:S)
+            println("  Total Annual Grid Revenue: ", round(total_grid_revenue / 1000, digits=2), " k$currency/year")
+        end
+    end
+
+    println("  Discounted Salvage Value: ", round(value(model[:Salvage_npv]) / 1000, digits=2), " k$currency")
+    actualized_demand = sum(sum(season_weights[s] * problem.load[t, s] for t in 1:T, s in 1:S) * problem.discount_factor[y] for y in 1:problem.project_lifetime)
+    lcoe = value(model[:NPC]) / actualized_demand
+    println("  Levelized Cost of Energy (LCOE) over actualized met demand: ", round(lcoe, digits=2), " $currency/kWh")
+
+    println("\nOptimal Operation:")
+
+    # Solar production & curtailment
+    if solar.enabled
+        total_solar_production = sum(season_weights[s] * value(model[:solar_production][t, s]) for t in 1:T, s in 1:S)
+        println("  Total Annual Solar Production: ", round(total_solar_production / 1000, digits=2), " MWh/year")
+
+        total_solar_max_production = sum(season_weights[s] * (problem.solar_unit_production[t, s] * value(model[:solar_units])) for t in 1:T, s in 1:S)
+        total_curtailment = total_solar_max_production - total_solar_production
+        println("  Annual Solar Curtailment Share: ", round((total_curtailment / total_solar_max_production) * 100, digits=2), " % of total solar production")
+    end
+
+    # Wind production & curtailment
+    if wind.enabled
+        total_wind_production = sum(season_weights[s] * value(model[:wind_production][t, s]) for t in 1:T, s in 1:S)
+        println("  Total Annual Wind Production: ", round(total_wind_production / 1000, digits=2), " MWh/year")
+
+        total_wind_max_production = sum(season_weights[s] * (problem.wind_power[t, s] * value(model[:wind_units])) for t in 1:T, s in 1:S)
+        total_curtailment = total_wind_max_production - total_wind_production
+        println("  Annual Wind Curtailment Share: ", round((total_curtailment / total_wind_max_production) * 100, digits=2), " % of total wind production")
+    end
+
+    # Battery charge & discharge
+    if battery.enabled
+        total_battery_discharge = sum(season_weights[s] * value(model[:battery_discharge][t, s]) for t in 1:T, s in 1:S)
+        total_battery_charge = sum(season_weights[s] * value(model[:battery_charge][t, s]) for t in 1:T, s in 1:S)
+
+        println("  Total Annual Battery Discharge: ", round(total_battery_discharge / 1000, digits=2), " MWh/year")
+        println("  Total Annual Battery Charge: ", round(total_battery_charge / 1000, digits=2), " MWh/year")
+    end
+
+    # Generator production
+    if generator.enabled
+        total_generator_production = sum(season_weights[s] * value(model[:generator_production][t, s]) for t in 1:T, s in 1:S)
+        println("  Total Annual Generator Production: ", round(total_generator_production / 1000, digits=2), " MWh/year")
+        total_fuel_consumption = sum(season_weights[s] * (value(model[:generator_production][t, s]) / generator.fuel_lhv) for t in 1:T, s in 1:S)
+        println("  Total Annual Fuel Consumption: ", round(total_fuel_consumption, digits=2), " liters/year")
+        if generator.allow_partial_load
+            generator_units = value(model[:generator_units])
+            avg_efficiency = generator_units > 0 ? total_generator_production / total_fuel_consumption : 0
+            println("  Average Generator Efficiency: ", round(avg_efficiency, digits=2), " kWh/liter")
+            avg_load_factor = generator_units > 0 ? total_generator_production / (generator_units * generator.nominal_capacity * 8760) : 0
+            println("  Average Generator Load Factor: ", round(avg_load_factor * 100, digits=2), " %")
+        end
+    end
+
+    # Grid import/export
+    if grid.allow_connection
+        total_grid_import = sum(season_weights[s] * value(model[:grid_import][t, s]) for t in 1:T, s in 1:S)
+        println("  Total Annual Grid Import: ", round(total_grid_import / 1000, digits=2), " MWh/year")
+
+        if grid.allow_export
+            total_grid_export = sum(season_weights[s] * value(model[:grid_export][t, s]) for t in 1:T, s in 1:S)
+            println("  Total Annual Grid Export: ", round(total_grid_export / 1000, digits=2), " MWh/year")
+        end
+        # Grid availability
+        average_grid_availability = sum(season_weights[s] * problem.grid_availability[t, s] for t in 1:T, s in 1:S)
+        println("  Average Annual Grid Availability: ", round((average_grid_availability / 8760) * 100, digits=2), " %")
+    end
+
+    # Compute lost load share safely
+    if has_lost_load(problem, formulation)
+        total_lost_load = sum(season_weights[s] * value(model[:lost_load][t, s]) for t in 1:T, s in 1:S)
+        total_load = sum(season_weights[s] * problem.load[t, s] for t in 1:T, s in 1:S)
+        println("  Lost Load Share: ", round((total_lost_load / total_load) * 100, digits=2), " % of total load")
+    end
+
+    # Compute renewable penetration safely
+    if solar.enabled || wind.enabled
+        total_renewable_generation = sum(season_weights[s] * value(model[:solar_production][t, s]) for t in 1:T, s in 1:S if solar.enabled; init=0.0) +
+                                     sum(season_weights[s] * value(model[:wind_production][t, s]) for t in 1:T, s in 1:S if wind.enabled; init=0.0)
+
+        total_generation = total_renewable_generation + sum(season_weights[s] * value(model[:generator_production][t, s]) for t in 1:T, s in 1:S if generator.enabled; init=0.0)
+
+        if total_generation > 0  # Avoid division by zero
+            renewable_penetration = (total_renewable_generation / total_generation) * 100
+            println("  Renewable Penetration: ", round(renewable_penetration, digits=2), " % of total generation")
+        else
+            println("  Renewable Penetration: N/A (No generation)")
+        end
+    end
+
+    display_uncertainty_results(model, problem, formulation)
+
+    println("\n----------------------------------------")
+end
+
+display_uncertainty_results(model::Model, problem::AutarkyProblem, ::Formulation) = nothing
+
+function display_uncertainty_results(model::Model, problem::AutarkyProblem, formulation::UncertainFormulation)
+    T = horizon(problem, formulation)
+    S = problem.S
+    season_weights = problem.season_weights
+
+    println("\nHandling Uncertainties:")
+
+    # Average Yearly Expected Shortfall (MWh)
+    avg_expected_shortfall = sum(season_weights[s] * sum(value(model[:expected_shortfall][t, s]) for t in 1:T) for s in 1:S) / 1000
+    println("  Average Yearly Expected Shortfall: ", round(avg_expected_shortfall, digits=2), " MWh")
+
+    # Average Yearly Battery Reserve (MWh)
+    if problem.battery.enabled
+        avg_battery_reserve = sum(season_weights[s] * sum(value(model[:battery_reserve][t, s]) for t in 1:T) for s in 1:S) / 1000
+        println("  Average Yearly Battery Reserve: ", round(avg_battery_reserve, digits=2), " MWh")
+    end
+
+    # Average Yearly Generator Reserve (MWh)
+    if problem.generator.enabled
+        avg_generator_reserve = sum(season_weights[s] * sum(value(model[:generator_reserve][t, s]) for t in 1:T) for s in 1:S) / 1000
+        println("  Average Yearly Generator Reserve: ", round(avg_generator_reserve, digits=2), " MWh")
+    end
+end
@@ -0,0 +1,147 @@
+# ------------------------------
+# FORMULATIONS
+# ------------------------------
+
+"""
+Optimization formulation of an Autarky problem. `build_model` and `solve_model!` dispatch on it.
+"""
+abstract type Formulation end
+
+"""
+Formulations with outages and forecast errors: reserves, expected shortfall and a horizon
+extended by the outage duration.
+"""
+abstract type UncertainFormulation <: Formulation end
+
+"""
+Least-cost sizing and dispatch assuming perfect foresight (LP/MILP, solved with the `solver_settings.solver` backend).
+"""
+struct Deterministic <: Formulation end
+
+Deterministic(problem::AutarkyProblem) = Deterministic()
+
+"""
+Settings of the expected shortfall penalty (`shortfall_settings` of parameters.yaml).
+
+# Fields:
+- `formulation::String`: "nonlinear" (registered operator, Ipopt) or "tangent_cuts" (linear outer approximation).
+- `cuts::Int`: Initial tangent cuts per time step and season.
+- `lp_solver::String`: Solver of the outer approximation ("highs", "gurobi" or "glpk").
+- `refinement_iterations::Int`: Cutting-plane rounds after the first solve.
+- `refinement_tolerance::Float64`: Relative approximation error accepted by the refinement.
+"""
+struct ShortfallSettings
+    formulation::String
+    cuts::Int
+    lp_solver::String
+    refinement_iterations::Int
+    refinement_tolerance::Float64
+end
+
+function ShortfallSettings(parameters::Dict)
+    shortfall_settings = get(parameters, "shortfall_settings", Dict())
+    formulation = get(shortfall_settings, "formulation", "nonlinear") # string
+    if !(formulation in ("nonlinear", "tangent_cuts"))
+        error("Invalid expected shortfall formulation: $formulation. Supported formulations are 'nonlinear' and 'tangent_cuts'.")
+    end
+    return ShortfallSettings(formulation, get(shortfall_settings, "cuts", 16), get(shortfall_settings, "lp_solver", "highs"),
+                             get(shortfall_settings, "refinement_iterations", 10),
+                             get(shortfall_settings, "refinement_tolerance", 1e-4))
+end
+
+"""
+Expected Value Model: the energy balance holds for the expected load and the expected shortfall is penalized.
+"""
+struct ExpectedValues <: UncertainFormulation
+    shortfall::ShortfallSettings
+end
+
+"""
+Individual Chance Constraints: the energy balance holds with the islanding probability at each time step.
+"""
+struct ICC <: UncertainFormulation
+    shortfall::ShortfallSettings
+end
+
+"""
+Settings of the joint chance constraint integration (`jcc_settings` of parameters.yaml).
+
+# Fields:
+- `integrator::String`: "qmc" (randomized lattice rule) or "mc" (plain Monte Carlo).
+- `samples::Int`, `shifts::Int`, `seed::Int`: Integration rule.
+- `adaptive::Bool`, `adaptive_samples::Vector{Int}`, `adaptive_tolerances::Vector{Float64}`: Adaptive accuracy schedule.
+- `verify_samples::Int`: Points per shift of the final check.
+- `threaded::Bool`: Thread-parallel window evaluation.
+- `hessian::String`: "exact" or "quasi-newton".
+"""
+struct JCCSettings
+    integrator::String
+    samples::Int
+    shifts::Int
+    seed::Int
+    adaptive::Bool
+    adaptive_samples::Vector{Int}
+    adaptive_tolerances::Vector{Float64}
+    verify_samples::Int
+    threaded::Bool
+    hessian::String
+end
+
+function JCCSettings(parameters::Dict)
+    # Defaults apply if the section is missing
+    jcc_settings = get(parameters, "jcc_settings", Dict())
+    samples = get(jcc_settings, "samples", 256)
+    hessian = get(jcc_settings, "hessian", "exact") # string
+    if !(hessian in ("exact", "quasi-newton"))
+        error("Invalid JCC Hessian mode: $hessian. Supported modes are 'exact' and 'quasi-newton'.")
+    end
+    return JCCSettings(get(jcc_settings, "integrator", "qmc"), samples, get(jcc_settings, "shifts", 8),
+                       get(jcc_settings, "seed", 1234), get(jcc_settings, "adaptive", false),
+                       Vector{Int}(get(jcc_settings, "adaptive_samples", [samples])),
+                       Vector{Float64}(get(jcc_settings, "adaptive_tolerances", Float64[])),
+                       get(jcc_settings, "verify_samples", 4096), get(jcc_settings, "threaded", false), hessian)
+end
+
+"""
+Joint Chance Constraints: the reserves cover every outage window jointly with the islanding probability.
+"""
+struct JCC <: UncertainFormulation
+    settings::JCCSettings
+end
+
+"""
+Check that the inputs of an uncertainty formulation define outages and forecast errors.
+"""
+function check_uncertainty(problem::AutarkyProblem, name::String)
+    if !problem.uncertainty.enabled
+        error("The $name formulation requires `uncertainty_settings` and prediction errors in the inputs.")
+    end
+end
+
+function ExpectedValues(problem::AutarkyProblem)
+    check_uncertainty(problem, "Expected Value")
+    return ExpectedValues(ShortfallSettings(problem.parameters))
+end
+
+function ICC(problem::AutarkyProblem)
+    check_uncertainty(problem, "ICC")
+    return ICC(ShortfallSettings(problem.parameters))
+end
+
+function JCC(problem::AutarkyProblem)
+    check_uncertainty(problem, "JCC")
+    return JCC(JCCSettings(problem.parameters))
+end
+
+"""
+Number of time steps of the model: the operation period, extended by the outage duration
+in the uncertainty formulations so that every outage window fits inside the horizon.
+"""
+horizon(problem::AutarkyProblem, ::Formulation) = problem.operation_time_steps
+horizon(problem::AutarkyProblem, ::UncertainFormulation) = problem.operation_time_steps + problem.uncertainty.outage_duration
+
+"""
+Reserves (battery and generator) are only held against outages.
+"""
+has_reserves(::Formulation) = false
+has_reserves(::UncertainFormulation) = true
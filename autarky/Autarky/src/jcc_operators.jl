@@ -0,0 +1,1002 @@
+module JCCOperators
+
+using LinearAlgebra, Random
+using Distributions: Normal, cdf, quantile
+
+# Number of integration points processed together by the separation-of-variables loop
+const BATCH_SIZE = 64
+
+# Standard normal helpers
+norm_cdf(x::Float64) = cdf(Normal(), x)
+norm_quantile(u::Float64) = quantile(Normal(), u)
+
+"""
+Lower Cholesky factor of a covariance matrix. Near-singular matrices (e.g. sample covariances
+of strongly correlated hours) get a growing diagonal jitter until the factorization succeeds.
+"""
+function covariance_factor(Σ::AbstractMatrix; max_attempts::Int = 8)
+    Σ_sym = Symmetric(Matrix{Float64}(Σ))
+    jitter = 0.0
+    scale = max(maximum(abs, diag(Σ_sym); init=0.0), eps())
+    for _ in 1:max_attempts
+        F = cholesky(Σ_sym + jitter * I; check=false)
+        if issuccess(F)
+            return Matrix(F.L)
+        end
+        jitter = jitter == 0.0 ? 1e-12 * scale : 10 * jitter
+    end
+    error("Covariance matrix of the outage window could not be factorized.")
+end
+
+# ----------------------------
+# INTEGRATION RULES
+# ----------------------------
+
+"""
+Point set used by the Genz integrator. A rule of dimension n integrates CDFs of up to n+1 variables;
+lower-dimensional integrals use its first coordinates.
+"""
+abstract type GenzRule end
+
+"""
+Plain Monte Carlo rule: uniform sample points drawn once.
+
+# Fields:
+- `points::Matrix{Float64}`: Sample points (capacity × n).
+- `active::Base.RefValue{Int}`: Number of points currently used (shared with the other rules of a store).
+"""
+struct MonteCarloRule <: GenzRule
+    points::Matrix{Float64}
+    active::Base.RefValue{Int}
+end
+
+"""
+Randomized rank-1 lattice rule (Richtmyer generators, periodized with the baker's transform).
+
+The estimate is the mean over `K` independent random shifts of an `N`-point lattice, and the
+spread of the shift means gives the error estimate. The points frac(i z) form an extensible
+sequence, so any leading `N` of them can be used (see `AccuracySchedule`).
+
+# Fields:
+- `points::Matrix{Float64}`: Unshifted lattice points frac(i z) (capacity × n).
+- `shifts::Matrix{Float64}`: Random shifts (n × K).
+- `active::Base.RefValue{Int}`: Number of points per shift currently used (shared with the other rules of a store).
+"""
+struct LatticeRule <: GenzRule
+    points::Matrix{Float64}
+    shifts::Matrix{Float64}
+    active::Base.RefValue{Int}
+end
+
+rule_dimension(rule::GenzRule) = size(rule.points, 2)
+active_points(rule::GenzRule) = min(rule.active[], size(rule.points, 1))
+
+"""
+First `n` prime numbers.
+"""
+function first_primes(n::Int)
+    primes = Int[]
+    candidate = 2
+    while length(primes) < n
+        if all(p -> candidate % p != 0, Iterators.takewhile(p -> p * p <= candidate, primes))
+            push!(primes, candidate)
+        end
+        candidate += 1
+    end
+    return primes
+end
+
+"""
+Build the integration rule of dimension `n`.
+
+# Arguments:
+- `integrator::String`: "qmc" (randomized lattice rule) or "mc" (plain Monte Carlo).
+- `capacity::Int`: Largest number of lattice points per shift (qmc) or sample points (mc).
+- `shifts::Int`: Number of random shifts (qmc only).
+- `seed::Int`: Seed of the random shifts or sample points.
+- `active::Base.RefValue{Int}`: Number of points currently used.
+"""
+function build_rule(n::Int, integrator::String, capacity::Int, shifts::Int, seed::Int, active::Base.RefValue{Int})
+    rng = MersenneTwister(seed)
+    if integrator == "mc"
+        return MonteCarloRule(rand(rng, capacity, n), active)
+    elseif integrator == "qmc"
+        z = [mod(sqrt(p), 1.0) for p in first_primes(n)]
+        points = [mod(i * z[j], 1.0) for i in 1:capacity, j in 1:n]
+        return LatticeRule(points, rand(rng, n, max(shifts, 2)), active)
+    else
+        error("Invalid JCC integrator: $integrator. Supported integrators are 'qmc' and 'mc'.")
+    end
+end
+
+"""
+Work buffers of the batched integrator (one batch of points × window size).
+"""
+struct GenzWorkspace
+    w::Matrix{Float64}
+    y::Matrix{Float64}
+    e::Vector{Float64}
+    f::Vector{Float64}
+    s::Vector{Float64}
+end
+
+GenzWorkspace(local_size::Int) = GenzWorkspace(zeros(BATCH_SIZE, max(local_size, 1)), zeros(BATCH_SIZE, max(local_size, 1)),
+                                               zeros(BATCH_SIZE), zeros(BATCH_SIZE), zeros(BATCH_SIZE))
+
+"""
+Separation-of-variables integrand over one batch of points stored in `ws.w`.
+Returns the sum and the sum of squares of the integrand over the batch.
+"""
+function sov_batch!(ws::GenzWorkspace, L::AbstractMatrix, b::AbstractVector, e_first::Float64, batch::Int)
+    d = length(b)
+    w, y, e, f, s = ws.w, ws.y, ws.e, ws.f, ws.s
+    @inbounds begin
+        @simd for p in 1:batch
+            e[p] = e_first
+            f[p] = e_first
+        end
+        for i in 2:d
+            @simd for p in 1:batch
+                y[p, i-1] = norm_quantile(clamp(w[p, i-1] * e[p], floatmin(Float64), prevfloat(1.0)))
+                s[p] = 0.0
+            end
+            for j in 1:i-1
+                L_ij = L[i, j]
+                @simd for p in 1:batch
+                    s[p] += L_ij * y[p, j]
+                end
+            end
+            inv_L_ii = 1 / L[i, i]
+            @simd for p in 1:batch
+                e[p] = norm_cdf((b[i] - s[p]) * inv_L_ii)
+                f[p] *= e[p]
+            end
+        end
+        total = 0.0
+        total_sq = 0.0
+        @simd for p in 1:batch
+            total += f[p]
+            total_sq += f[p]^2
+        end
+    end
+    return total, total_sq
+end
+
+"""
+Genz separation-of-variables estimate of P(Z ≤ b) for Z ~ N(0, L Lᵀ), with an error estimate
+(three standard errors). Up to `EXACT_MAX_DIMENSION` variables the CDF is computed by the
+deterministic kernels instead, which are noise-free and much faster than sampling.
+"""
+function genz_cdf(L::AbstractMatrix, b::AbstractVector, rule::GenzRule, ws::GenzWorkspace)
+    d = length(b)
+    d == 0 && return 1.0, 0.0
+    e_first = norm_cdf(b[1] / L[1, 1])
+    d == 1 && return e_first, 0.0
+    d <= EXACT_MAX_DIMENSION && return exact_cdf(L, b)
+    rule_dimension(rule) >= d - 1 || error("Integration rule of dimension $(rule_dimension(rule)) cannot integrate $d variables.")
+    return integrate(rule, L, b, e_first, ws)
+end
+
+function integrate(rule::MonteCarloRule, L, b, e_first, ws::GenzWorkspace)
+    d = length(b)
+    m = active_points(rule)
+    total = 0.0
+    total_sq = 0.0
+    for start in 1:BATCH_SIZE:m
+        batch = min(BATCH_SIZE, m - start + 1)
+        @inbounds for j in 1:d-1, p in 1:batch
+            ws.w[p, j] = rule.points[start+p-1, j]
+        end
+        batch_total, batch_sq = sov_batch!(ws, L, b, e_first, batch)
+        total += batch_total
+        total_sq += batch_sq
+    end
+    estimate = total / m
+    variance = max(total_sq / m - estimate^2, 0.0) / m
+    return estimate, 3 * sqrt(variance)
+end
+
+function integrate(rule::LatticeRule, L, b, e_first, ws::GenzWorkspace)
+    d = length(b)
+    N = active_points(rule)
+    K = size(rule.shifts, 2)
+    mean_acc = 0.0
+    mean_sq_acc = 0.0
+    for k in 1:K
+        shift_total = 0.0
+        for start in 1:BATCH_SIZE:N
+            batch = min(BATCH_SIZE, N - start + 1)
+            @inbounds for j in 1:d-1
+                shift = rule.shifts[j, k]
+                @simd for p in 1:batch
+                    # Shifted lattice point, periodized with the baker's (tent) transform
+                    ws.w[p, j] = abs(2 * mod(rule.points[start+p-1, j] + shift, 1.0) - 1)
+                end
+            end
+            shift_total += sov_batch!(ws, L, b, e_first, batch)[1]
+        end
+        shift_mean = shift_total / N
+        mean_acc += shift_mean
+        mean_sq_acc += shift_mean^2
+    end
+    estimate = mean_acc / K
+    variance = max(mean_sq_acc / K - estimate^2, 0.0) * K / (K - 1) / K
+    return estimate, 3 * sqrt(variance)
+end
+
+# ----------------------------
+# EXACT LOW-DIMENSIONAL KERNELS
+# ----------------------------
+
+# Windows of up to this many variables are integrated with the deterministic kernels below
+const EXACT_MAX_DIMENSION = 3
+# Absolute tolerance of the one-dimensional integral of the trivariate kernel
+const TVN_TOLERANCE = 1e-13
+
+# Gauss–Legendre rules with 6, 12 and 20 points (negative nodes only, the rules are symmetric)
+const GL_NODES = (
+    [-0.9324695142031519, -0.6612093864662645, -0.2386191860831969],
+    [-0.9815606342467192, -0.9041172563704748, -0.7699026741943047, -0.5873179542866175, -0.3678314989981802,
+     -0.1252334085114689],
+    [-0.993128599185095, -0.9639719272779138, -0.912234428251326, -0.8391169718222188, -0.7463319064601508,
+     -0.636053680726515, -0.5108670019508271, -0.37370608871541955, -0.22778585114164507, -0.07652652113349734],
+)
+const GL_WEIGHTS = (
+    [0.17132449237917027, 0.3607615730481387, 0.46791393457269104],
+    [0.04717533638651141, 0.10693932599531907, 0.16007832854334642, 0.20316742672306573, 0.2334925365383546,
+     0.2491470458134027],
+    [0.017614007139150893, 0.040601429800386446, 0.06267204833410879, 0.08327674157670471, 0.1019301198172407,
+     0.1181945319615186, 0.1316886384491769, 0.1420961093183824, 0.14917298647260424, 0.15275338713072628],
+)
+
+# Gauss–Kronrod 7/15-point rule (nodes in decreasing order, the last one is the centre)
+const GK_NODES = [0.991455371120812639, 0.949107912342758525, 0.864864423359769073, 0.741531185599394440,
+                  0.586087235467691130, 0.405845151377397167, 0.207784955007898468, 0.0]
+const GK_WEIGHTS = [0.022935322010529225, 0.063092092629978553, 0.104790010322250184, 0.140653259715525919,
+                    0.169004726639267903, 0.190350578064785410, 0.204432940075298892, 0.209482141084727828]
+const GAUSS_WEIGHTS = [0.129484966168869693, 0.279705391489276668, 0.381830050505118945, 0.417959183673469388]
+
+"""
+Upper bivariate normal probability P(X > h, Y > k) for standard normals with correlation `r`.
+
+Drezner–Wesolowsky method as refined by Genz: Gauss–Legendre integration of Sheppard's formula
+for moderate correlations, and of an asymptotic expansion around |r| = 1 otherwise.
+The result is accurate to about 1e-15.
+"""
+function bvn_upper(h::Float64, k::Float64, r::Float64)
+    abs_r = abs(r)
+    rule = abs_r < 0.3 ? 1 : abs_r < 0.75 ? 2 : 3
+    x, w = GL_NODES[rule], GL_WEIGHTS[rule]
+    hk = h * k
+    bvn = 0.0
+    if abs_r < 0.925
+        hs = (h^2 + k^2) / 2
+        asr = asin(r)
+        for i in eachindex(x), side in (-1, 1)
+            sn = sin(asr * (side * x[i] + 1) / 2)
+            bvn += w[i] * exp((sn * hk - hs) / (1 - sn^2))
+        end
+        return bvn * asr / (4 * pi) + norm_cdf(-h) * norm_cdf(-k)
+    end
+
+    if r < 0
+        k = -k
+        hk = -hk
+    end
+    if abs_r < 1
+        a2 = (1 - r) * (1 + r)
+        a = sqrt(a2)
+        bs = (h - k)^2
+        c = (4 - hk) / 8
+        d = (12 - hk) / 16
+        bvn = a * exp(-(bs / a2 + hk) / 2) * (1 - c * (bs - a2) * (1 - d * bs / 5) / 3 + c * d * a2^2 / 5)
+        if hk > -160
+            b = sqrt(bs)
+            bvn -= exp(-hk / 2) * sqrt(2 * pi) * norm_cdf(-b / a) * b * (1 - c * bs * (1 - d * bs / 5) / 3)
+        end
+        a /= 2
+        for i in eachindex(x), side in (-1, 1)
+            xs = (a * (side * x[i] + 1))^2
+            rs = sqrt(1 - xs)
+            asr = -(bs / xs + hk) / 2
+            if asr > -100
+                bvn += a * w[i] * exp(asr) * (exp(-hk * (1 - rs) / (2 * (1 + rs))) / rs - (1 + c * xs * (1 + d * xs)))
+            end
+        end
+        bvn = -bvn / (2 * pi)
+    end
+    if r > 0
+        bvn += norm_cdf(-max(h, k))
+    else
+        bvn = -bvn
+        if k > h
+            bvn += h < 0 ? norm_cdf(k) - norm_cdf(h) : norm_cdf(-h) - norm_cdf(-k)
+        end
+    end
+    return bvn
+end
+
+"""
+Bivariate normal CDF P(X ≤ h, Y ≤ k) for standard normals with correlation `r`.
+"""
+bvn_cdf(h::Float64, k::Float64, r::Float64) = bvn_upper(-h, -k, r)
+
+"""
+Adaptive Gauss–Kronrod integration of `f` over [a, b]: the subinterval with the largest error
+estimate is bisected until the total estimate falls below `tol`.
+
+# Returns:
+- `value::Float64`, `error::Float64`: Integral and its error estimate.
+"""
+function adaptive_kronrod(f, a::Float64, b::Float64, tol::Float64; max_intervals::Int = 100)
+    function kronrod(lo, hi)
+        centre = (lo + hi) / 2
+        half = (hi - lo) / 2
+        f_centre = f(centre)
+        kronrod_sum = GK_WEIGHTS[8] * f_centre
+        gauss_sum = GAUSS_WEIGHTS[4] * f_centre
+        for j in 1:7
+            f_pair = f(centre - half * GK_NODES[j]) + f(centre + half * GK_NODES[j])
+            kronrod_sum += GK_WEIGHTS[j] * f_pair
+            if iseven(j)
+                gauss_sum += GAUSS_WEIGHTS[j ÷ 2] * f_pair
+            end
+        end
+        return kronrod_sum * half, abs((kronrod_sum - gauss_sum) * half)
+    end
+
+    intervals = [(a, b, kronrod(a, b)...)]
+    total_error = intervals[1][4]
+    while total_error > tol && length(intervals) < max_intervals
+        worst = argmax(i -> intervals[i][4], eachindex(intervals))
+        lo, hi, _, _ = intervals[worst]
+        mid = (lo + hi) / 2
+        intervals[worst] = (lo, mid, kronrod(lo, mid)...)
+        push!(intervals, (mid, hi, kronrod(mid, hi)...))
+        total_error = sum(interval[4] for interval in intervals)
+    end
+    return sum(interval[3] for interval in intervals), total_error
+end
+
+"""
+Integrand of Plackett's identity along the correlation path of the trivariate kernel
+(Genz, "Numerical computation of rectangular bivariate and trivariate normal and t probabilities", 2004).
+"""
+function plackett_integrand(ba::Float64, bb::Float64, bc::Float64, ra::Float64, rb::Float64, r::Float64, rr::Float64)
+    dt = rr * (rr - (ra - rb)^2 - 2 * ra * rb * (1 - r))
+    dt > 0 || return 0.0
+    bt = (bc * rr + ba * (r * rb - ra) + bb * (r * ra - rb)) / sqrt(dt)
+    ft = (ba - r * bb)^2 / rr + bb^2
+    (bt > -10 && ft < 100) || return 0.0
+    value = exp(-ft / 2)
+    return bt < 10 ? value * norm_cdf(bt) : value
+end
+
+"""
+Trivariate normal CDF P(X₁ ≤ h₁, X₂ ≤ h₂, X₃ ≤ h₃) for standard normals with correlations `r12`, `r13`, `r23`.
+
+Genz's method: the variables are ordered so that |r23| is the largest correlation, the CDF with
+r12 = r13 = 0 is a product of univariate and bivariate CDFs, and the difference to the actual
+correlations is a one-dimensional integral (Plackett's identity) computed by adaptive quadrature.
+
+# Returns:
+- `p::Float64`, `err::Float64`: CDF and the error estimate of the quadrature.
+"""
+function tvn_cdf(h1::Float64, h2::Float64, h3::Float64, r12::Float64, r13::Float64, r23::Float64)
+    if abs(r12) > abs(r13)
+        h2, h3 = h3, h2
+        r12, r13 = r13, r12
+    end
+    if abs(r13) > abs(r23)
+        h1, h2 = h2, h1
+        r13, r23 = r23, r13
+    end
+
+    ε = 1e-14
+    if abs(h1) + abs(h2) + abs(h3) < ε
+        return (1 + (asin(r12) + asin(r13) + asin(r23)) / (pi / 2)) / 8, 0.0
+    elseif abs(r12) + abs(r13) < ε
+        return norm_cdf(h1) * bvn_cdf(h2, h3, r23), 0.0
+    elseif abs(r13) + abs(r23) < ε
+        return norm_cdf(h3) * bvn_cdf(h1, h2, r12), 0.0
+    elseif abs(r12) + abs(r23) < ε
+        return norm_cdf(h2) * bvn_cdf(h1, h3, r13), 0.0
+    elseif 1 - r23 < ε
+        return bvn_cdf(h1, min(h2, h3), r12), 0.0
+    elseif r23 + 1 < ε
+        return (h2 > -h3 ? bvn_cdf(h1, h2, r12) - bvn_cdf(h1, -h3, r12) : 0.0), 0.0
+    end
+
+    asin_12 = asin(r12)
+    asin_13 = asin(r13)
+    integrand(t) = begin
+        s12 = sin(asin_12 * t)
+        s13 = sin(asin_13 * t)
+        value = 0.0
+        if asin_12 != 0
+            value += asin_12 * plackett_integrand(h1, h2, h3, s13, r23, s12, 1 - s12^2)
+        end
+        if asin_13 != 0
+            value += asin_13 * plackett_integrand(h1, h3, h2, s12, r23, s13, 1 - s13^2)
+        end
+        value
+    end
+    correction, err = adaptive_kronrod(integrand, 0.0, 1.0, TVN_TOLERANCE * 2 * pi)
+    p = norm_cdf(h1) * bvn_cdf(h2, h3, r23) + correction / (2 * pi)
+    return clamp(p, 0.0, 1.0), err / (2 * pi)
+end
+
+"""
+Deterministic CDF of N(0, L Lᵀ) at `b` for two or three variables.
+"""
+function exact_cdf(L::AbstractMatrix, b::AbstractVector)
+    d = length(b)
+    σ = ntuple(i -> sqrt(sum(L[i, j]^2 for j in 1:i)), d)
+    h = ntuple(i -> b[i] / σ[i], d)
+    correlation(i, j) = clamp(sum(L[i, m] * L[j, m] for m in 1:min(i, j)) / (σ[i] * σ[j]), -1.0, 1.0)
+    if d == 2
+        return clamp(bvn_cdf(h[1], h[2], correlation(1, 2)), 0.0, 1.0), 0.0
+    else
+        return tvn_cdf(h[1], h[2], h[3], correlation(1, 2), correlation(1, 3), correlation(2, 3))
+    end
+end
+
+# ----------------------------
+# WINDOW FACTORIZATIONS
+# ----------------------------
+
+"""
+Precomputed data for the conditional CDF of a window given its `k`-th variable.
+
+Conditioning on x_k leaves the remaining D variables normal with mean
+μ_{-k} + β (x_k - μ_k) and covariance Σ_{-k,-k} - Σ_{-k,k} Σ_{k,-k} / Σ_{k,k}, both independent of x.
+
+# Fields:
+- `others::Vector{Int}`: Window positions of the remaining variables.
+- `β::Vector{Float64}`: Regression coefficients Σ_{-k,k} / Σ_{k,k}.
+- `L::Matrix{Float64}`: Lower Cholesky factor of the conditional covariance.
+"""
+struct ConditionalFactor
+    others::Vector{Int}
+    β::Vector{Float64}
+    L::Matrix{Float64}
+end
+
+"""
+Precomputed data for the second derivative of a window CDF with respect to a pair (k, l) of its variables.
+
+∂²F/∂x_k∂x_l is the bivariate density of (x_k, x_l) times the CDF of the remaining D-1 variables
+given both, which are normal with mean μ_o + B (x_{kl} - μ_{kl}) and covariance
+Σ_{o,o} - B Σ_{kl,o}, with B = Σ_{o,kl} Σ_{kl,kl}⁻¹.
+
+# Fields:
+- `k::Int`, `l::Int`: Window positions of the pair (k > l, i.e. a lower-triangle Hessian entry).
+- `others::Vector{Int}`: Window positions of the remaining variables.
+- `B::Matrix{Float64}`: Regression coefficients on the pair ((D-1) × 2).
+- `L_pair::Matrix{Float64}`: Lower Cholesky factor of Σ_{kl,kl}.
+- `L::Matrix{Float64}`: Lower Cholesky factor of the conditional covariance.
+"""
+struct PairFactor
+    k::Int
+    l::Int
+    others::Vector{Int}
+    B::Matrix{Float64}
+    L_pair::Matrix{Float64}
+    L::Matrix{Float64}
+end
+
+"""
+Bivariate normal density of the centered pair values (z_k, z_l).
+"""
+function pair_density(pair::PairFactor, z_k::Float64, z_l::Float64)
+    L = pair.L_pair
+    u_k = z_k / L[1, 1]
+    u_l = (z_l - L[2, 1] * u_k) / L[2, 2]
+    return exp(-(u_k^2 + u_l^2) / 2) / (2 * pi * L[1, 1] * L[2, 2])
+end
+
+"""
+Factorized outage window: everything the JCC callbacks need that does not depend on the window point.
+
+# Fields:
+- `μ::Vector{Float64}`, `σ::Vector{Float64}`: Mean and standard deviation of the window errors.
+- `L::Matrix{Float64}`: Lower Cholesky factor of the window covariance.
+- `conditional::Vector{ConditionalFactor}`: One conditional factorization per window variable.
+- `pairs::Vector{PairFactor}`: One pairwise factorization per off-diagonal Hessian entry.
+- `rule::GenzRule`: Integration rule reused by every integration of the window.
+"""
+struct WindowFactors
+    μ::Vector{Float64}
+    σ::Vector{Float64}
+    L::Matrix{Float64}
+    conditional::Vector{ConditionalFactor}
+    pairs::Vector{PairFactor}
+    rule::GenzRule
+end
+
+"""
+Factorize the covariance of an outage window, of its D+1 conditional distributions given one
+variable and of its (D+1)D/2 conditional distributions given a pair of variables.
+
+# Arguments:
+- `rule::GenzRule`: Integration rule of dimension ≥ D used for the window.
+"""
+function factorize_window(μ::AbstractVector, σ::AbstractVector, Σ::AbstractMatrix, rule::GenzRule)
+    local_size = length(μ)
+    conditional = ConditionalFactor[]
+    for k in 1:local_size
+        others = [i for i in 1:local_size if i != k]
+        β = Σ[others, k] ./ Σ[k, k]
+        Σ_cond = Σ[others, others] - (Σ[others, k] * transpose(Σ[k, others])) ./ Σ[k, k]
+        L_cond = isempty(others) ? zeros(0, 0) : covariance_factor(Σ_cond)
+        push!(conditional, ConditionalFactor(others, β, L_cond))
+    end
+    pairs = PairFactor[]
+    for k in 1:local_size, l in 1:k-1
+        pair = [k, l]
+        others = [i for i in 1:local_size if i != k && i != l]
+        L_pair = covariance_factor(Σ[pair, pair])
+        if isempty(others)
+            B, L_cond = zeros(0, 2), zeros(0, 0)
+        else
+            B = Σ[others, pair] / (L_pair * transpose(L_pair))
+            L_cond = covariance_factor(Σ[others, others] - B * Σ[pair, others])
+        end
+        push!(pairs, PairFactor(k, l, others, B, L_pair, L_cond))
+    end
+    return WindowFactors(Vector{Float64}(μ), Vector{Float64}(σ), covariance_factor(Σ), conditional, pairs, rule)
+end
+
+"""
+Registry of factorized outage windows, deduplicated by covariance fingerprint.
+
+With stationary or repeating forecast errors many windows have the same mean and covariance
+slices; they then share a single `WindowFactors` instead of factorizing and storing their own
+copy. Integration rules are built once per dimension and shared by all windows of the same size.
+
+# Fields:
+- `factors::Dict{Tuple{Vector{Float64}, Matrix{Float64}}, WindowFactors}`: Factorized windows by fingerprint.
+- `rules::Dict{Int, GenzRule}`: Integration rules by dimension.
+- `requests::Int`: Number of windows requested from the registry.
+- `integrator::String`, `capacity::Int`, `shifts::Int`, `seed::Int`: Integration rule settings (see `build_rule`).
+- `active::Base.RefValue{Int}`: Number of points currently used by all rules of the store.
+- `digits::Int`: Significant digits kept in the fingerprint.
+"""
+mutable struct WindowFactorStore
+    factors::Dict{Tuple{Vector{Float64}, Matrix{Float64}}, WindowFactors}
+    rules::Dict{Int, GenzRule}
+    requests::Int
+    integrator::String
+    capacity::Int
+    shifts::Int
+    seed::Int
+    active::Base.RefValue{Int}
+    digits::Int
+end
+
+WindowFactorStore(; integrator::String = "qmc", samples::Int = 256, capacity::Int = samples, shifts::Int = 8, seed::Int = 1234, digits::Int = 10) =
+    WindowFactorStore(Dict{Tuple{Vector{Float64}, Matrix{Float64}}, WindowFactors}(), Dict{Int, GenzRule}(), 0,
+                      integrator, max(capacity, samples), shifts, seed, Ref(samples), digits)
+
+"""
+Fingerprint of an outage window: its mean and covariance rounded to `digits` significant digits.
+"""
+window_fingerprint(μ::AbstractVector, Σ::AbstractMatrix, digits::Int) =
+    (round.(Vector{Float64}(μ); sigdigits=digits), round.(Matrix{Float64}(Σ); sigdigits=digits))
+
+"""
+Return the factorization of an outage window, reusing the one of an identical window if already computed.
+"""
+function shared_window_factors!(store::WindowFactorStore, μ::AbstractVector, σ::AbstractVector, Σ::AbstractMatrix)
+    store.requests += 1
+    n = max(length(μ) - 1, 0)
+    rule = get!(store.rules, n) do
+        build_rule(n, store.integrator, store.capacity, store.shifts, store.seed, store.active)
+    end
+    return get!(store.factors, window_fingerprint(μ, Σ, store.digits)) do
+        factorize_window(μ, σ, Σ, rule)
+    end
+end
+
+"""
+Print how many outage windows share a factorization.
+"""
+function report_window_sharing(store::WindowFactorStore)
+    println("JCC windows: $(store.requests) registered, $(length(store.factors)) distinct covariance factorizations.")
+end
+
+# ----------------------------
+# JUMP OPERATORS
+# ----------------------------
+
+"""
+Memo shared by the value and gradient callbacks of one JCC outage window.
+
+Ipopt usually requests `f` and `∇f` at the same iterate, so the memo keeps the last
+window point together with the full-window CDF and the D+1 conditional CDFs computed there.
+A new point invalidates both entries.
+
+# Fields:
+- `x::Vector{Float64}`: Window point (reserve mismatch over the outage window) of the cached entries.
+- `cdf::Float64`, `cdf_error::Float64`: Full-window CDF at `x` and its error estimate (valid if `has_cdf`).
+- `conditional_cdf::Vector{Float64}`: Conditional CDFs of the remaining D variables given each window variable (valid if `has_conditional`).
+- `conditional_error::Vector{Float64}`: Error estimates of the conditional CDFs.
+- `pair_cdf::Vector{Float64}`: Conditional CDFs of the remaining D-1 variables given each pair of window variables (valid if `has_pairs`).
+- `hits::Int`, `misses::Int`: Number of cached and computed Genz integrations, for reporting.
+"""
+mutable struct WindowCache
+    x::Vector{Float64}
+    cdf::Float64
+    cdf_error::Float64
+    has_cdf::Bool
+    conditional_cdf::Vector{Float64}
+    conditional_error::Vector{Float64}
+    has_conditional::Bool
+    pair_cdf::Vector{Float64}
+    has_pairs::Bool
+    hits::Int
+    misses::Int
+end
+
+WindowCache(local_size::Int) = WindowCache(fill(NaN, local_size), NaN, 0.0, false, zeros(local_size), zeros(local_size), false,
+                                           zeros(local_size * (local_size - 1) ÷ 2), false, 0, 0)
+
+"""
+Drop the cached integrations (e.g. after a change of integration accuracy).
+"""
+function invalidate!(cache::WindowCache)
+    cache.has_cdf = false
+    cache.has_conditional = false
+    cache.has_pairs = false
+    return cache
+end
+
+"""
+Point the memo at `x`, dropping the cached integrations if the window point has changed.
+"""
+function sync_cache!(cache::WindowCache, x)
+    if any(i -> cache.x[i] != x[i], eachindex(cache.x))
+        for i in eachindex(cache.x)
+            cache.x[i] = x[i]
+        end
+        invalidate!(cache)
+    end
+    return cache
+end
+
+"""
+Conditional CDF of the remaining D variables of a window given its `local_idx`-th variable,
+stored in the window cache. `shifted_b` and `ws` are work buffers of the calling task.
+"""
+function conditional_cdf!(cache::WindowCache, factors::WindowFactors, centered_x::Vector{Float64}, local_idx::Int,
+                          shifted_b::Vector{Float64}, ws::GenzWorkspace)
+    cond = factors.conditional[local_idx]
+    # Remaining variables given x_k: bounds shifted by the regression on x_k
+    for (j, i) in enumerate(cond.others)
+        shifted_b[j] = centered_x[i] - cond.β[j] * centered_x[local_idx]
+    end
+    cache.conditional_cdf[local_idx], cache.conditional_error[local_idx] = genz_cdf(cond.L, shifted_b, factors.rule, ws)
+    return cache
+end
+
+"""
+Conditional CDF of the remaining D-1 variables of a window given its `p`-th pair of variables,
+stored in the window cache. `shifted_b` and `ws` are work buffers of the calling task.
+"""
+function pair_cdf!(cache::WindowCache, factors::WindowFactors, centered_x::Vector{Float64}, p::Int,
+                   shifted_b::Vector{Float64}, ws::GenzWorkspace)
+    pair = factors.pairs[p]
+    # Remaining variables given (x_k, x_l): bounds shifted by the regression on the pair
+    for (j, i) in enumerate(pair.others)
+        shifted_b[j] = centered_x[i] - pair.B[j, 1] * centered_x[pair.k] - pair.B[j, 2] * centered_x[pair.l]
+    end
+    cache.pair_cdf[p] = genz_cdf(pair.L, shifted_b, factors.rule, ws)[1]
+    return cache
+end
+
+"""
+Define the multivariate normal CDF of an outage window with its gradient and Hessian, for registration as a JuMP operator.
+
+The callbacks take the D+1 window variables as arguments and share a `WindowCache`.
+Off-diagonal Hessian entries are pairwise densities times conditional CDFs (see `PairFactor`);
+the diagonal follows from differentiating the gradient formula,
+∂²F/∂x_k² = -(x_k - μ_k)/σ_k² ∂F/∂x_k - Σ_{l≠k} β_l ∂²F/∂x_k∂x_l.
+All covariance factorizations are done beforehand (see `shared_window_factors!`), so the
+callbacks only shift the integration bounds and integrate. Windows of up to three variables
+(outage_duration ≤ 2), and the conditional CDFs of four-variable windows, use the exact kernels;
+larger ones use the integration rule of the window.
+
+# Arguments:
+- `factors::WindowFactors`: Factorized outage window (possibly shared with identical windows).
+
+# Keyword Arguments:
+- `threaded::Bool`: Run the conditional integrations of the gradient and Hessian on `Threads.nthreads()` threads.
+  Each integration has its own work buffers and the integration rules hold no random state,
+  so the results do not depend on the thread count or scheduling. Windows small enough for
+  the exact kernels are always evaluated serially.
+
+# Returns:
+- `f`, `∇f`, `∇²f`, `cache`: Value, gradient and Hessian callbacks and their shared memo.
+"""
+function define_distribution(factors::WindowFactors; threaded::Bool = false)
+    # Local PDF for standard normal
+    norm_pdf(k) = exp(-(k^2)/2) / sqrt(2*pi)
+
+    # The operator only receives the D+1 window variables
+    local_size = length(factors.μ)
+    outage_duration = local_size - 1
+
+    cache = WindowCache(local_size)
+    centered_x = zeros(local_size)
+    ws = GenzWorkspace(local_size)
+    # One set of conditional work buffers per gradient component and Hessian entry when threaded
+    num_pairs = length(factors.pairs)
+    use_threads = threaded && Threads.nthreads() > 1 && outage_duration > EXACT_MAX_DIMENSION
+    shifted_bs = [zeros(outage_duration) for _ in 1:(use_threads ? local_size : 1)]
+    pair_bs = [zeros(max(outage_duration - 1, 0)) for _ in 1:(use_threads ? num_pairs : 1)]
+    conditional_ws = [GenzWorkspace(local_size) for _ in 1:(use_threads ? max(local_size, num_pairs) : 0)]
+
+    # Conditional CDFs given one variable (gradient) and given a pair of variables (Hessian)
+    update_conditionals!() = begin
+        if cache.has_conditional
+            cache.hits += local_size
+            return
+        end
+        if use_threads
+            Threads.@threads for local_idx in 1:local_size
+                conditional_cdf!(cache, factors, centered_x, local_idx, shifted_bs[local_idx], conditional_ws[local_idx])
+            end
+        else
+            for local_idx in 1:local_size
+                conditional_cdf!(cache, factors, centered_x, local_idx, shifted_bs[1], ws)
+            end
+        end
+        cache.has_conditional = true
+        cache.misses += local_size
+    end
+    update_pairs!() = begin
+        if cache.has_pairs
+            cache.hits += num_pairs
+            return
+        end
+        if use_threads
+            Threads.@threads for p in 1:num_pairs
+                pair_cdf!(cache, factors, centered_x, p, pair_bs[p], conditional_ws[p])
+            end
+        else
+            for p in 1:num_pairs
+                pair_cdf!(cache, factors, centered_x, p, pair_bs[1], ws)
+            end
+        end
+        cache.has_pairs = true
+        cache.misses += num_pairs
+    end
+    gradient(local_idx) = begin
+        σ_k = factors.σ[local_idx]
+        norm_pdf(centered_x[local_idx] / σ_k) / σ_k * cache.conditional_cdf[local_idx]
+    end
+
+    # Multivariate CDF function for outage window
+    f(x...) = begin
+        try
+            if length(x) != local_size
+                println("WARNING: Length mismatch in f(x...): x=$(length(x)) vs window=$(local_size)")
+            end
+
+            sync_cache!(cache, x)
+            if cache.has_cdf
+                cache.hits += 1
+                return cache.cdf
+            end
+
+            for i in 1:local_size
+                centered_x[i] = x[i] - factors.μ[i]
+            end
+
+            cache.cdf, cache.cdf_error = genz_cdf(factors.L, centered_x, factors.rule, ws)
+            cache.has_cdf = true
+            cache.misses += 1
+            return cache.cdf
+        catch e
+            println("ERROR inside f(x...): $e")
+            rethrow()
+        end
+    end
+
+    # Gradient of Multivariate CDF (g is indexed by position inside the window)
+    function ∇f(g::AbstractVector{T}, x::T...) where {T}
+        try
+            sync_cache!(cache, x)
+            for i in 1:local_size
+                centered_x[i] = x[i] - factors.μ[i]
+            end
+            update_conditionals!()
+
+            for local_idx in 1:local_size
+                g[local_idx] = gradient(local_idx)
+            end
+
+        catch e
+            println("ERROR inside ∇f(x...): $e")
+            rethrow()
+        end
+        return
+    end
+
+    # Hessian of Multivariate CDF (lower triangle of H, indexed by position inside the window)
+    function ∇²f(H::AbstractMatrix{T}, x::T...) where {T}
+        try
+            sync_cache!(cache, x)
+            for i in 1:local_size
+                centered_x[i] = x[i] - factors.μ[i]
+            end
+            update_conditionals!()
+            update_pairs!()
+
+            for (p, pair) in enumerate(factors.pairs)
+                H[pair.k, pair.l] = pair_density(pair, centered_x[pair.k], centered_x[pair.l]) * cache.pair_cdf[p]
+            end
+            for k in 1:local_size
+                cond = factors.conditional[k]
+                h_kk = -centered_x[k] / factors.σ[k]^2 * gradient(k)
+                for (j, l) in enumerate(cond.others)
+                    h_kk -= cond.β[j] * H[max(k, l), min(k, l)]
+                end
+                H[k, k] = h_kk
+            end
+
+        catch e
+            println("ERROR inside ∇²f(x...): $e")
+            rethrow()
+        end
+        return
+    end
+
+    return f, ∇f, ∇²f, cache
+end
+
+"""
+Print how many Genz integrations were served from the JCC window memos, and the largest
+error estimate of the last window CDFs.
+"""
+function report_cache_usage(caches::Vector{WindowCache})
+    hits = sum(c.hits for c in caches; init=0)
+    misses = sum(c.misses for c in caches; init=0)
+    total = hits + misses
+    share = total > 0 ? round(100 * hits / total, digits=1) : 0.0
+    println("JCC evaluation cache: $hits of $total Genz integrations reused ($share %).")
+    max_error = maximum(c.cdf_error for c in caches if c.has_cdf; init=0.0)
+    println("JCC integration: largest CDF error estimate at the last evaluated points: $(round(max_error, sigdigits=3)).")
+end
+
+"""
+Reset the reuse counts of the JCC window memos (e.g. after the timed runs of the linear solver benchmark).
+"""
+function reset_cache_usage!(caches::Vector{WindowCache})
+    for cache in caches
+        cache.hits = 0
+        cache.misses = 0
+    end
+    return caches
+end
+
+# ----------------------------
+# ADAPTIVE ACCURACY
+# ----------------------------
+
+"""
+Schedule of integration accuracy along the Ipopt run.
+
+Early iterates are far from the optimum and only need a rough CDF, so the integration starts
+with `samples[1]` points and moves to the next entry each time max(primal, dual infeasibility)
+drops below the matching entry of `tolerances`. Window caches are invalidated at every change
+so that no value computed at a lower accuracy is reused.
+
+# Fields:
+- `store::WindowFactorStore`: Store whose rules follow the schedule.
+- `caches::Vector{WindowCache}`: Caches of all JCC windows.
+- `samples::Vector{Int}`: Increasing point counts.
+- `tolerances::Vector{Float64}`: Infeasibility thresholds to move from `samples[i]` to `samples[i+1]`.
+- `level::Int`: Current entry of `samples`.
+"""
+mutable struct AccuracySchedule
+    store::WindowFactorStore
+    caches::Vector{WindowCache}
+    samples::Vector{Int}
+    tolerances::Vector{Float64}
+    level::Int
+end
+
+function AccuracySchedule(store::WindowFactorStore, caches::Vector{WindowCache}, samples::Vector{Int}, tolerances::Vector{Float64})
+    if isempty(samples) || length(tolerances) < length(samples) - 1
+        error("Invalid JCC accuracy schedule: one tolerance is needed between two consecutive sample counts.")
+    end
+    schedule = AccuracySchedule(store, caches, samples, tolerances, 1)
+    set_accuracy!(schedule, 1)
+    return schedule
+end
+
+"""
+Move the schedule to `level` and invalidate the window caches if the point count changes.
+"""
+function set_accuracy!(schedule::AccuracySchedule, level::Int)
+    schedule.level = level
+    samples = min(schedule.samples[level], schedule.store.capacity)
+    if schedule.store.active[] != samples
+        schedule.store.active[] = samples
+        foreach(invalidate!, schedule.caches)
+    end
+    return schedule
+end
+
+"""
+Ipopt intermediate callback advancing the schedule as the iterates converge
+(to be set with `MOI.set(model, Ipopt.CallbackFunction(), callback)`).
+"""
+function accuracy_callback(schedule::AccuracySchedule)
+    return function (alg_mod, iter_count, obj_value, inf_pr, inf_du, mu, d_norm, regularization_size, alpha_du, alpha_pr, ls_trials)
+        infeasibility = max(inf_pr, inf_du)
+        level = schedule.level
+        while level < length(schedule.samples) && infeasibility < schedule.tolerances[level]
+            level += 1
+        end
+        if level != schedule.level
+            set_accuracy!(schedule, level)
+            println("JCC integration: iteration $iter_count, infeasibility $(round(infeasibility, sigdigits=3)) → $(schedule.store.active[]) points per shift.")
+        end
+        return true
+    end
+end
+
+"""
+Check the JCC windows at a given point with a high-accuracy integration.
+
+# Arguments:
+- `store::WindowFactorStore`: Store of the window factorizations.
+- `windows::Vector{WindowFactors}`: Factorization of each window.
+- `points::Vector{Vector{Float64}}`: Window points (e.g. optimal reserve mismatch) of each window.
+- `target::Float64`: Required joint probability (islanding probability).
+
+# Keyword Arguments:
+- `samples::Int`: Points per shift of the check (capped at the store capacity).
+- `threaded::Bool`: Check the windows on `Threads.nthreads()` threads (one work buffer per window).
+
+# Returns:
+- `probabilities::Vector{Float64}`, `errors::Vector{Float64}`: Window CDFs and their error estimates.
+"""
+function verify_windows(store::WindowFactorStore, windows::Vector{WindowFactors}, points::Vector{Vector{Float64}},
+                        target::Float64; samples::Int = store.capacity, threaded::Bool = false)
+    previous = store.active[]
+    store.active[] = min(samples, store.capacity)
+    probabilities = zeros(length(windows))
+    errors = zeros(length(windows))
+    try
+        check_window(w) = begin
+            factors = windows[w]
+            ws = GenzWorkspace(length(factors.μ))
+            probabilities[w], errors[w] = genz_cdf(factors.L, points[w] .- factors.μ, factors.rule, ws)
+        end
+        if threaded && Threads.nthreads() > 1
+            Threads.@threads for w in eachindex(windows)
+                check_window(w)
+            end
+        else
+            foreach(check_window, eachindex(windows))
+        end
+    finally
+        store.active[] = previous
+    end
+
+    violations = count(w -> probabilities[w] + errors[w] < target, eachindex(windows))
+    if !isempty(windows)
+        println("\nJCC verification ($(min(samples, store.capacity)) points per shift): lowest window probability ",
+                round(minimum(probabilities), digits=4), " (target $target, largest error estimate ",
+                round(maximum(errors), sigdigits=3), ").")
+        if violations > 0
+            println("Warning: $violations JCC windows are below the target islanding probability at the final point.")
+        end
+    end
+    return probabilities, errors
+end
+
+end # module JCCOperators
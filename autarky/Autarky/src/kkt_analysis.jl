@@ -0,0 +1,253 @@
+# ========================
+# KKT PRE-FLIGHT ANALYSIS
+# ========================
+
+# Orderings of MC68 (`ord` argument of mc68_order)
+const KKT_ORDERINGS = Dict("amd" => 1, "md" => 2, "metis" => 3)
+
+"""
+Settings of the pre-flight analysis of the Ipopt KKT system (`preflight_settings` of parameters.yaml).
+
+# Fields:
+- `enabled::Bool`: Forecast the factorization of the KKT system after the model build.
+- `orderings::Vector{String}`: Fill-reducing orderings to compare ("amd", "md", "metis").
+- `solve::Bool`: Solve the model after the analysis (false: stop after the report).
+"""
+struct PreflightSettings
+    enabled::Bool
+    orderings::Vector{String}
+    solve::Bool
+end
+
+function PreflightSettings(parameters::Dict)
+    preflight_settings = get(parameters, "preflight_settings", Dict())
+    orderings = Vector{String}(get(preflight_settings, "orderings", ["amd", "metis"]))
+    for ordering in orderings
+        if !haskey(KKT_ORDERINGS, ordering)
+            error("Invalid KKT ordering: $ordering. Supported orderings are 'amd', 'md' and 'metis'.")
+        end
+    end
+    return PreflightSettings(get(preflight_settings, "enabled", false), orderings, get(preflight_settings, "solve", true))
+end
+
+# C structures of hsl_mc68i.h and hsl_mc78i.h
+mutable struct MC68Control
+    f_array_in::Cint
+    f_array_out::Cint
+    min_l_workspace::Cint
+    lp::Cint
+    wp::Cint
+    mp::Cint
+    nemin::Cint
+    print_level::Cint
+    row_full_thresh::Cint
+    row_search::Cint
+    MC68Control() = new()
+end
+
+mutable struct MC68Info
+    flag::Cint
+    iostat::Cint
+    stat::Cint
+    out_range::Cint
+    duplicate::Cint
+    n_compressions::Cint
+    n_zero_eigs::Cint
+    l_workspace::Clong
+    zb01_info::Cint
+    n_dense_rows::Cint
+    MC68Info() = new()
+end
+
+mutable struct MC78Control
+    f_arrays::Cint
+    heuristic::Cint
+    nrelax::NTuple{3, Cint}
+    zrelax::NTuple{3, Cdouble}
+    nemin::Cint
+    unit_error::Cint
+    unit_warning::Cint
+    ssa_abort::Cint
+    svar::Cint
+    sort::Cint
+    lopt::Cint
+    MC78Control() = new()
+end
+
+"""
+Whether Ipopt uses the exact Hessian of the Lagrangian in the KKT system of a formulation.
+"""
+exact_hessian(::Formulation) = true
+exact_hessian(formulation::JCC) = formulation.settings.hessian == "exact"
+
+# Variables Ipopt removes from its problem (fixed_variable_treatment = make_parameter, the default)
+is_fixed_column(x::VariableRef) =
+    is_fixed(x) || (has_lower_bound(x) && has_upper_bound(x) && lower_bound(x) == upper_bound(x))
+
+"""
+Sparsity pattern of the KKT matrix that Ipopt factorizes for a built model,
+
+    [W  0   J_c'  J_d']
+    [0  Σ_s  0    -I  ]
+    [J_c 0   0     0  ]
+    [J_d -I  0     0  ],
+
+with the Hessian of the Lagrangian W, the Jacobians J_c and J_d of the equality and inequality rows and
+one slack column per inequality row (Ipopt's d(x) - s = 0). Fixed variables are removed, as Ipopt does
+by default. Diagonal entries are included for every column (Ipopt's barrier and regularization terms).
+Entries that are structurally present but numerically zero are kept, so the forecast is an upper bound.
+
+# Arguments:
+- `model::Model`: Model returned by `build_model(problem, formulation)`.
+- `formulation::Formulation`: The formulation the model was built with.
+
+# Returns:
+- `ptr::Vector{Cint}`, `row::Vector{Cint}`: Lower triangle of the pattern, compressed by columns (1-based).
+"""
+function kkt_pattern(model::Model, formulation::Formulation)
+    variables = all_variables(model)
+    column = Dict(index(x) => k for (k, x) in enumerate(filter(!is_fixed_column, variables)))
+    columns = [Int[k] for k in 1:length(column)]  # Row indices of each column, diagonal included
+    add_column!() = (push!(columns, Int[length(columns) + 1]); length(columns))
+    entry!(i, j) = push!(columns[min(i, j)], max(i, j))
+    # Row of a constraint, with its slack column if it is an inequality
+    function add_row!(equality::Bool)
+        r = add_column!()
+        equality || entry!(r, add_column!())
+        return r
+    end
+
+    # Linear and quadratic constraint rows
+    for (F, S) in list_of_constraint_types(model)
+        F <: Union{GenericAffExpr, GenericQuadExpr} || continue
+        for con in all_constraints(model, F, S)
+            r = add_row!(S <: MOI.EqualTo)
+            f = constraint_object(con).func
+            for x in keys(f isa GenericQuadExpr ? f.aff.terms : f.terms)
+                haskey(column, index(x)) && entry!(r, column[index(x)])
+            end
+            if f isa GenericQuadExpr
+                for pair in keys(f.terms)
+                    if haskey(column, index(pair.a)) && haskey(column, index(pair.b))
+                        entry!(column[index(pair.a)], column[index(pair.b)])
+                    end
+                end
+            end
+        end
+    end
+
+    # Nonlinear rows, with the Hessian of their Lagrangian. The evaluator numbers its columns by
+    # `ordered`, mapped to the KKT columns like the linear rows.
+    if num_nonlinear_constraints(model) > 0
+        nlp = nonlinear_model(model)
+        ordered = index.(variables)
+        evaluator = MOI.Nonlinear.Evaluator(nlp, MOI.Nonlinear.SparseReverseMode(), ordered)
+        hessian = exact_hessian(formulation) && :Hess in MOI.features_available(evaluator)
+        MOI.initialize(evaluator, hessian ? [:Jac, :Hess] : [:Jac])
+        nonlinear_rows = [add_row!(constraint.set isa MOI.EqualTo) for constraint in values(nlp.constraints)]
+        for (i, j) in MOI.jacobian_structure(evaluator)
+            haskey(column, ordered[j]) && entry!(nonlinear_rows[i], column[ordered[j]])
+        end
+        if hessian
+            for (i, j) in MOI.hessian_lagrangian_structure(evaluator)
+                if haskey(column, ordered[i]) && haskey(column, ordered[j])
+                    entry!(column[ordered[i]], column[ordered[j]])
+                end
+            end
+        end
+    end
+
+    ptr = Cint[1]
+    row = Cint[]
+    for rows in columns
+        append!(row, sort!(unique!(rows)))
+        push!(ptr, length(row) + 1)
+    end
+    return ptr, row
+end
+
+"""
+Symbolic factorization of a KKT pattern with one ordering: MC68 computes the fill-reducing ordering
+and MC78 the assembly tree of the multifrontal factorization (as HSL_MA97 does in its analysis).
+
+# Returns:
+- `stats::NamedTuple`: Factor nonzeros, flops, supernodes, largest front, memory forecast [GB] and analysis time [s].
+"""
+function symbolic_factorization(ptr::Vector{Cint}, row::Vector{Cint}, ordering::String)
+    n = length(ptr) - 1
+    start = time()
+
+    control = MC68Control()
+    ccall((:mc68_default_control_i, HSL_jll.libhsl), Cvoid, (Ref{MC68Control},), control)
+    control.f_array_in = 1
+    control.f_array_out = 1
+    info = MC68Info()
+    perm = Vector{Cint}(undef, n)
+    ccall((:mc68_order_i, HSL_jll.libhsl), Cvoid,
+          (Cint, Cint, Ptr{Cint}, Ptr{Cint}, Ptr{Cint}, Ref{MC68Control}, Ref{MC68Info}),
+          KKT_ORDERINGS[ordering], n, ptr, row, perm, control, info)
+    info.flag < 0 && error("MC68 $ordering ordering failed (flag $(info.flag)).")
+
+    control78 = MC78Control()
+    ccall((:mc78_default_control_i, HSL_jll.libhsl), Cvoid, (Ref{MC78Control},), control78)
+    control78.f_arrays = 1
+    nnodes, stat = Ref{Cint}(0), Ref{Cint}(0)
+    sptr, sparent, rlist = Ref{Ptr{Cint}}(C_NULL), Ref{Ptr{Cint}}(C_NULL), Ref{Ptr{Cint}}(C_NULL)
+    rptr = Ref{Ptr{Int64}}(C_NULL)
+    nfact, nflops = Ref{Int64}(0), Ref{Int64}(0)
+    flag = ccall((:mc78_analyse_asm_i, HSL_jll.libhsl), Cint,
+                 (Cint, Ptr{Cint}, Ptr{Cint}, Ptr{Cint}, Ref{Cint}, Ref{Ptr{Cint}}, Ref{Ptr{Cint}}, Ref{Ptr{Int64}},
+                  Ref{Ptr{Cint}}, Ref{MC78Control}, Ref{Cint}, Ref{Int64}, Ref{Int64}, Ptr{Cint}),
+                 n, ptr, row, perm, nnodes, sptr, sparent, rptr, rlist, control78, stat, nfact, nflops, C_NULL)
+    flag < 0 && error("MC78 analysis with the $ordering ordering failed (flag $flag).")
+
+    # Front of each supernode: its row list
+    row_starts = copy(unsafe_wrap(Array, rptr[], nnodes[] + 1))
+    max_front = maximum(diff(row_starts); init=0)
+    foreach(Libc.free, (sptr[], sparent[], rptr[], rlist[]))
+
+    # Factor values, row lists and the largest dense frontal matrix
+    memory = (8 * nfact[] + 4 * (row_starts[end] - row_starts[1]) + 8 * max_front^2) / 1e9
+    return (nfact=nfact[], nflops=nflops[], nnodes=Int(nnodes[]), max_front=Int(max_front), memory=memory,
+            time=time() - start)
+end
+
+"""
+Forecast the factorization of the Ipopt KKT system of a built model with each ordering, before solving it.
+
+# Arguments:
+- `model::Model`: Model returned by `build_model(problem, formulation)`.
+- `formulation::Formulation`: The formulation the model was built with.
+- `settings::PreflightSettings`: The orderings to compare.
+
+# Returns:
+- `report::DataFrame`: One row per ordering with the predicted factor nonzeros, flops and peak memory.
+"""
+function analyse_kkt(model::Model, formulation::Formulation, settings::PreflightSettings)
+    hsl_functional() || error("The KKT pre-flight analysis needs a functional HSL library (MC68 and MC78).")
+    ptr, row = kkt_pattern(model, formulation)
+    n = length(ptr) - 1
+    println("\nKKT pre-flight analysis: order $n, $(length(row)) nonzeros in the lower triangle.")
+
+    report = DataFrame("Ordering" => String[], "KKT Order" => Int[], "KKT Nonzeros" => Int[],
+                       "Factor Nonzeros" => Int[], "Flops" => Float64[], "Supernodes" => Int[],
+                       "Largest Front" => Int[], "Peak Memory [GB]" => Float64[], "Analysis Time [s]" => Float64[])
+    for ordering in settings.orderings
+        stats = symbolic_factorization(ptr, row, ordering)
+        push!(report, (ordering, n, length(row), stats.nfact, stats.nflops, stats.nnodes, stats.max_front,
+                       stats.memory, stats.time))
+        println("  $ordering: $(stats.nfact) factor nonzeros, $(stats.nflops) flops, ",
+                "largest front $(stats.max_front), peak memory $(round(stats.memory; digits=3)) GB")
+    end
+    return report
+end
+
+"""
+Write the pre-flight analysis to `kkt_analysis.csv` in a results folder.
+"""
+function write_kkt_analysis_to_csv(report::DataFrame, results_dir::String)
+    mkpath(results_dir)
+    report_path = joinpath(results_dir, "kkt_analysis.csv")
+    CSV.write(report_path, report)
+    println("KKT pre-flight analysis written to $report_path")
+end
@@ -0,0 +1,269 @@
+# ========================
+# IPOPT LINEAR SOLVERS
+# ========================
+
+# HSL linear solvers of Ipopt (ma86 and ma97 factorize in parallel with OpenMP, see OMP_NUM_THREADS;
+# ma77 factorizes out of core)
+const HSL_SOLVERS = ("ma27", "ma57", "ma77", "ma86", "ma97")
+
+# Solvers timed by the linear solver benchmark by default
+const BENCHMARK_CANDIDATES = ("ma27", "ma57", "ma86", "ma97")
+
+# Scaling and ordering presets of the HSL linear solvers. The KKT rows mix kWh, liters and thousands of
+# currency units: "robust" scales them by MC64 matching (fewer delayed pivots), "fast" skips scaling
+# and orders with AMD for well-scaled models, and "large" orders with METIS, amalgamates bigger
+# supernodes and lowers the MA97 parallel thresholds for the full-year models. The thresholds
+# (factor_min, solve_min) are not Ipopt options and need the MA97 analysis cache. No preset uses the
+# matching-based MA97 orderings ("matched-*"): they read the matrix values, so their analyses are not cached.
+const LINEAR_SOLVER_PRESETS = Dict(
+    "fast" => (options=Dict("linear_system_scaling" => "none",
+                            "ma57_automatic_scaling" => "no", "ma57_pivot_order" => 0,
+                            "ma86_scaling" => "none", "ma86_order" => "amd",
+                            "ma97_scaling" => "none", "ma97_order" => "amd", "ma97_nemin" => 8),
+               factor_min=-1, solve_min=-1),
+    "robust" => (options=Dict("linear_system_scaling" => "mc19",
+                              "ma57_automatic_scaling" => "yes", "ma57_pivot_order" => 5,
+                              "ma86_scaling" => "mc64", "ma86_order" => "auto",
+                              "ma97_scaling" => "mc64", "ma97_order" => "auto", "ma97_nemin" => 8),
+                 factor_min=-1, solve_min=-1),
+    "large" => (options=Dict("linear_system_scaling" => "mc19",
+                             "ma57_automatic_scaling" => "yes", "ma57_pivot_order" => 4,
+                             "ma57_node_amalgamation" => 32, "ma57_block_size" => 64,
+                             "ma86_scaling" => "mc77", "ma86_order" => "metis", "ma86_nemin" => 64,
+                             "ma97_scaling" => "mc77", "ma97_order" => "metis", "ma97_nemin" => 32,
+                             "ma97_solve_blas3" => "yes"),
+                factor_min=2_000_000, solve_min=20_000))
+
+"""
+Settings of the Ipopt linear solvers (`solver_settings.linear_solver_settings` of parameters.yaml).
+
+# Fields:
+- `benchmark::Bool`: Time the candidates on the model before solving it and keep the fastest one.
+- `candidates::Vector{String}`: HSL linear solvers to time.
+- `benchmark_iterations::Int`: Ipopt iterations of each timed run.
+- `preset::String`: Scaling and ordering preset of the HSL solvers ("fast", "robust", "large"; "" for Ipopt's defaults).
+- `ma97_cache::Bool`: Reuse the MA97 symbolic analysis of each KKT sparsity pattern across the solves of the session.
+- `ma77_scratch_dir::String`: Directory of the MA77 factor files ("" for the system temporary directory).
+- `ma77_memory_budget_gb::Float64`: Factor storage kept in memory before MA77 writes to its factor files [GB].
+"""
+struct LinearSolverSettings
+    benchmark::Bool
+    candidates::Vector{String}
+    benchmark_iterations::Int
+    preset::String
+    ma97_cache::Bool
+    ma77_scratch_dir::String
+    ma77_memory_budget_gb::Float64
+end
+
+function LinearSolverSettings(parameters::Dict)
+    linear_solver_settings = get(parameters["solver_settings"], "linear_solver_settings", Dict())
+    candidates = Vector{String}(get(linear_solver_settings, "candidates", collect(BENCHMARK_CANDIDATES)))
+    for candidate in candidates
+        if !(candidate in HSL_SOLVERS)
+            error("Invalid linear solver candidate: $candidate. Supported candidates are '$(join(HSL_SOLVERS, "', '"))'.")
+        end
+    end
+    preset = get(linear_solver_settings, "preset", "") # string
+    if !(isempty(preset) || haskey(LINEAR_SOLVER_PRESETS, preset))
+        error("Invalid linear solver preset: $preset. Supported presets are 'fast', 'robust' and 'large'.")
+    end
+    return LinearSolverSettings(get(linear_solver_settings, "benchmark", false), candidates,
+                                get(linear_solver_settings, "benchmark_iterations", 10), preset,
+                                get(linear_solver_settings, "ma97_cache", false),
+                                get(linear_solver_settings, "ma77_scratch_dir", ""),
+                                get(linear_solver_settings, "ma77_memory_budget_gb", 8.0))
+end
+
+# Result of the HSL probe (nothing until the first Ipopt optimizer is built)
+const HSL_FUNCTIONAL = Ref{Union{Nothing, Bool}}(nothing)
+
+libhsl_isfunctional() = ccall((:LIBHSL_isfunctional, HSL_jll.libhsl), Bool, ())
+
+"""
+Whether the HSL library of HSL_jll is installed and functional (`LIBHSL_isfunctional`). The dummy
+library shipped without an HSL licence, or no library at all, makes Ipopt fail on the first factorization.
+"""
+function hsl_functional()
+    if HSL_FUNCTIONAL[] === nothing
+        HSL_FUNCTIONAL[] = try
+            HSL_jll.is_available() && isdefined(HSL_jll, :libhsl) && libhsl_isfunctional()
+        catch
+            false
+        end
+    end
+    return HSL_FUNCTIONAL[]
+end
+
+"""
+HSL library given to Ipopt: the MA97 analysis cache in front of the HSL library when it is enabled
+and built, the HSL library itself otherwise.
+"""
+function hsl_library(settings::LinearSolverSettings)
+    if settings.ma97_cache
+        if ma97_cache_available()
+            hsllib = init_ma97_cache(HSL_jll.libhsl_path)
+            preset = get(LINEAR_SOLVER_PRESETS, settings.preset, (factor_min=-1, solve_min=-1))
+            set_ma97_thresholds(preset.factor_min, preset.solve_min)
+            return hsllib
+        end
+        println("Warning: the MA97 analysis cache is not built (`] build Autarky`), MA97 analyses are not reused.")
+    end
+    return HSL_jll.libhsl_path
+end
+
+"""
+MA97 ordering of an Ipopt solve: `ma97_order` of `ipopt_options`, of the preset, or Ipopt's default.
+"""
+function ma97_order(settings::LinearSolverSettings, ipopt_options::Dict)
+    preset_options = isempty(settings.preset) ? Dict() : LINEAR_SOLVER_PRESETS[settings.preset].options
+    return get(ipopt_options, "ma97_order", get(preset_options, "ma97_order", "auto"))
+end
+
+"""
+Set the Ipopt options of the linear solver preset, except those given in `ipopt_options`.
+"""
+function set_preset!(optimizer, settings::LinearSolverSettings, ipopt_options::Dict)
+    isempty(settings.preset) && return optimizer
+    for (key, value) in LINEAR_SOLVER_PRESETS[settings.preset].options
+        haskey(ipopt_options, key) || set_optimizer_attribute(optimizer, key, value)
+    end
+    return optimizer
+end
+
+"""
+Point an Ipopt optimizer to the HSL library for an HSL linear solver, or fall back to MUMPS without a
+functional HSL library.
+
+# Arguments:
+- `optimizer`: Ipopt optimizer factory.
+- `linear_solver::String`: The `linear_solver` of `ipopt_options`.
+- `settings::LinearSolverSettings`: The linear solver settings.
+- `ipopt_options::Dict`: The `ipopt_options` of parameters.yaml, which take precedence over the preset.
+"""
+function set_linear_solver!(optimizer, linear_solver::String, settings::LinearSolverSettings, ipopt_options::Dict)
+    linear_solver in HSL_SOLVERS || return optimizer
+    if hsl_functional()
+        set_optimizer_attribute(optimizer, "hsllib", hsl_library(settings))
+        set_preset!(optimizer, settings, ipopt_options)
+        if settings.ma97_cache && startswith(ma97_order(settings, ipopt_options), "matched")
+            println("Warning: the matching-based MA97 ordering ($(ma97_order(settings, ipopt_options))) reads the matrix values, ",
+                    "MA97 analyses are not reused.")
+        end
+        if linear_solver == "ma77"
+            # In-core storage in double words (an Ipopt integer option)
+            maxstore = min(round(Int, settings.ma77_memory_budget_gb * 1e9 / 8), typemax(Int32))
+            set_optimizer_attribute(optimizer, "ma77_maxstore", maxstore)
+        end
+    else
+        println("Warning: the HSL library is not functional, Ipopt uses MUMPS instead of $linear_solver.")
+        set_optimizer_attribute(optimizer, "linear_solver", "mumps")
+    end
+    return optimizer
+end
+
+# Fastest linear solver of each problem size (variables, constraints) benchmarked in this session
+const LINEAR_SOLVER_CHOICES = Dict{Tuple{Int, Int}, String}()
+
+"""
+Time short Ipopt runs of a model with each candidate linear solver and set the fastest one.
+
+Every run starts from the start values of the model and stops after `benchmark_iterations`
+iterations, so the runs do the same work up to the factorizations. Runs go through the solver hooks
+of the formulation and, for ma77, the factor directory (`with_factor_files`), like the solve itself;
+the JCC cache counts of the runs are dropped. The choice is kept per problem size for the later
+models of the session (sweeps, continuation levels, batch jobs).
+
+# Arguments:
+- `model::Model`: Model with its Ipopt optimizer attached.
+- `problem::AutarkyProblem`: The project data.
+- `formulation::Formulation`: The formulation the model was built with.
+- `settings::LinearSolverSettings`: The candidates and the length of the timed runs.
+
+# Returns:
+- `linear_solver::String`: The linear solver set on the model.
+"""
+function benchmark_linear_solvers!(model::Model, problem::AutarkyProblem, formulation::Formulation,
+                                   settings::LinearSolverSettings)
+    ipopt_options = get(problem.parameters["solver_settings"], "ipopt_options", Dict())
+    size = (num_variables(model), num_constraints(model; count_variable_in_set_constraints=false) + num_nonlinear_constraints(model))
+    linear_solver = get!(LINEAR_SOLVER_CHOICES, size) do
+        println("\nBenchmarking the linear solvers on $(size[1]) variables and $(size[2]) constraints...")
+        set_attribute(model, "hsllib", hsl_library(settings))
+        set_attribute(model, "max_iter", settings.benchmark_iterations)
+        set_attribute(model, "print_level", 0)
+        times = Dict{String, Float64}()
+        for candidate in settings.candidates
+            set_attribute(model, "linear_solver", candidate)
+            prepare_solve!(model, problem, formulation)
+            with_factor_files(() -> optimize!(model), model, problem)
+            status = termination_status(model)
+            if status in (MOI.ITERATION_LIMIT, MOI.LOCALLY_SOLVED, MOI.ALMOST_LOCALLY_SOLVED)
+                times[candidate] = solve_time(model)
+                println("  $candidate: $(round(times[candidate]; digits=3)) s")
+            else
+                println("  $candidate: failed ($status)")
+            end
+        end
+        set_attribute(model, "max_iter", get(ipopt_options, "max_iter", 3000))
+        set_attribute(model, "print_level", get(ipopt_options, "print_level", 5))
+        if formulation isa JCC
+            reset_cache_usage!(model.ext[:jcc].caches)
+        end
+        isempty(times) && error("Linear solver benchmark failed: no candidate completed $(settings.benchmark_iterations) iterations.")
+        argmin(times)
+    end
+    set_attribute(model, "linear_solver", linear_solver)
+    println("Linear solver: $linear_solver")
+    return linear_solver
+end
+
+"""
+Ipopt option set on the optimizer of a model (by `ipopt_options`, the MUMPS fallback or the benchmark),
+or `default` if it has not been set.
+"""
+function ipopt_attribute(model::Model, name::String, default)
+    try
+        return get_attribute(model, name)
+    catch err
+        err isa MOI.GetAttributeNotAllowed || rethrow()
+        return default
+    end
+end
+
+# Ipopt options naming files, resolved against the working directory of the caller before an MA77 solve
+# ("ipopt.opt" is the option file Ipopt reads from the working directory by default)
+const IPOPT_FILE_OPTIONS = ("output_file" => "", "option_file_name" => "ipopt.opt")
+
+"""
+Run `solve` in a new directory of the scratch storage when Ipopt factorizes out of core with MA77:
+Ipopt opens the MA77 factor files (ma77_int, ma77_real, ma77_work, ma77_delay) in the working
+directory. The directory and its files are removed once the solve returns.
+
+The linear solver is read from the optimizer of the model (benchmark runs, MUMPS fallback). `solve`
+runs with the process working directory changed to the factor directory: relative Ipopt file options
+(`output_file`, an `ipopt.opt` of the working directory) are made absolute first.
+
+# Arguments:
+- `solve::Function`: The solve, without arguments.
+- `model::Model`: Model with its optimizer attached.
+- `problem::AutarkyProblem`: The project data.
+"""
+function with_factor_files(solve::Function, model::Model, problem::AutarkyProblem)
+    if solver_name(model) != "Ipopt" || ipopt_attribute(model, "linear_solver", "mumps") != "ma77" || !hsl_functional()
+        return solve()
+    end
+    for (option, default) in IPOPT_FILE_OPTIONS
+        path = string(ipopt_attribute(model, option, default))
+        if !isempty(path) && !isabspath(path) && (option != "option_file_name" || isfile(path))
+            set_attribute(model, option, abspath(path))
+        end
+    end
+    settings = LinearSolverSettings(problem.parameters)
+    scratch_dir = isempty(settings.ma77_scratch_dir) ? tempdir() : settings.ma77_scratch_dir
+    mkpath(scratch_dir)
+    return mktempdir(scratch_dir; prefix="ma77_") do factor_dir
+        println("MA77 factor files in $factor_dir ($(settings.ma77_memory_budget_gb) GB in core).")
+        cd(solve, factor_dir)
+    end
+end
@@ -0,0 +1,65 @@
+module MA97Cache
+
+import Libdl
+
+"""
+MA97 analysis cache built by deps/build.jl (deps/ma97_cache). Given to Ipopt as its `hsllib`, it
+forwards the MA97 routines to the HSL library and reuses the symbolic analysis (ordering and
+assembly tree) of every KKT sparsity pattern already analysed in the session. The other HSL solvers
+resolve to the HSL library itself.
+"""
+const libma97_cache = joinpath(@__DIR__, "..", "deps", "ma97_cache", "libma97_cache.$(Libdl.dlext)")
+
+# HSL library the cache forwards to (empty until `init_ma97_cache`)
+const HSL_LIBRARY = Ref("")
+
+"""
+Whether the MA97 analysis cache library has been built.
+"""
+ma97_cache_available() = isfile(libma97_cache)
+
+"""
+Load the MA97 routines of an HSL library into the cache. Initialized once per session.
+
+# Arguments:
+- `hsllib::String`: Path of the HSL library (`HSL_jll.libhsl_path`).
+
+# Returns:
+- `path::String`: Path of the cache library, to set as Ipopt's `hsllib`.
+"""
+function init_ma97_cache(hsllib::String)
+    if HSL_LIBRARY[] != hsllib
+        status = ccall((:ma97_cache_init, libma97_cache), Cint, (Cstring,), hsllib)
+        status == 0 || error("The MA97 analysis cache could not load the MA97 routines of $hsllib.")
+        HSL_LIBRARY[] = hsllib
+    end
+    return libma97_cache
+end
+
+"""
+Override the parallel thresholds of the MA97 factorizations and solves (`control.factor_min` and
+`control.solve_min`, not Ipopt options). A negative value keeps the value set by Ipopt.
+"""
+function set_ma97_thresholds(factor_min::Integer, solve_min::Integer)
+    ccall((:ma97_cache_set_thresholds, libma97_cache), Cvoid, (Clong, Clong), factor_min, solve_min)
+end
+
+"""
+Print how many MA97 analyses were reused from the cache since the start of the session.
+"""
+function report_ma97_cache()
+    isempty(HSL_LIBRARY[]) && return nothing
+    hits, misses, entries = Ref{Clong}(0), Ref{Clong}(0), Ref{Cint}(0)
+    ccall((:ma97_cache_stats, libma97_cache), Cvoid, (Ref{Clong}, Ref{Clong}, Ref{Cint}), hits, misses, entries)
+    println("MA97 analyses: $(hits[]) reused, $(misses[]) computed ($(entries[]) sparsity patterns cached).")
+end
+
+"""
+Free the cached MA97 analyses that no Ipopt solve holds.
+"""
+function clear_ma97_cache()
+    isempty(HSL_LIBRARY[]) || ccall((:ma97_cache_clear, libma97_cache), Cvoid, ())
+    return nothing
+end
+
+end # module MA97Cache
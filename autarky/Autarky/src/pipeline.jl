@@ -0,0 +1,138 @@
+# ========================
+# ICC → JCC WARM START
+# ========================
+
+"""
+Settings of the JCC warm start (`pipeline_settings` of parameters.yaml).
+
+# Fields:
+- `warm_start::String`: "icc" (solve the ICC model in-process and start from its solution) or "none" (cold start).
+- `ipopt_warm_start_options::Dict{Any, Any}`: Ipopt options of the warm-started solve.
+"""
+struct PipelineSettings
+    warm_start::String
+    ipopt_warm_start_options::Dict{Any, Any}
+end
+
+function PipelineSettings(parameters::Dict)
+    pipeline_settings = get(parameters, "pipeline_settings", Dict())
+    warm_start = get(pipeline_settings, "warm_start", "icc") # string
+    if !(warm_start in ("icc", "none"))
+        error("Invalid JCC warm start: $warm_start. Supported warm starts are 'icc' and 'none'.")
+    end
+    return PipelineSettings(warm_start, Dict{Any, Any}(get(pipeline_settings, "ipopt_warm_start_options",
+                                                           Dict("warm_start_init_point" => "yes"))))
+end
+
+"""
+Copy the solution of a solved model into the start values of another model of the same problem.
+
+Variables and constraints are matched by their registered names (`model[:battery_reserve]`,
+`model[:soc_balance]`, ...) and must have the same axes in both models. Primal values become
+start values; with duals available, the constraint duals, the bound duals of the matched variables
+and the duals of the nonlinear expected shortfall rows become dual start values. Objects of one
+model only (the ICC energy balance, the JCC reserve mismatch, ...) are skipped.
+
+# Arguments:
+- `target::Model`: The model to start.
+- `source::Model`: The solved model.
+
+# Returns:
+- `num_starts::Int`: Number of primal and dual start values set.
+"""
+function transfer_solution!(target::Model, source::Model)
+    has_values(source) || error("The source model has no solution to transfer.")
+    with_duals = has_duals(source)
+    num_starts = 0
+    for (name, object) in object_dictionary(source)
+        haskey(target, name) || continue
+        target_object = target[name]
+        if object isa AbstractArray && target_object isa AbstractArray
+            axes(object) == axes(target_object) || continue
+            for (x, y) in zip(object, target_object)
+                num_starts += transfer_start!(y, x, with_duals)
+            end
+        else
+            num_starts += transfer_start!(target_object, object, with_duals)
+        end
+    end
+
+    # Nonlinear rows are matched through the (t, s) of their expected shortfall penalty
+    if with_duals && haskey(source.ext, :shortfall_rows) && haskey(target.ext, :shortfall_rows)
+        nonlinear_duals = zeros(num_nonlinear_constraints(target))
+        for (row, target_row) in zip(source.ext[:shortfall_rows], target.ext[:shortfall_rows])
+            nonlinear_duals[target_row.index.value] = dual(row)
+            num_starts += 1
+        end
+        set_nonlinear_dual_start_value(target, nonlinear_duals)
+    end
+    return num_starts
+end
+
+function transfer_start!(y::VariableRef, x::VariableRef, with_duals::Bool)
+    set_start_value(y, value(x))
+    num_starts = 1
+    if with_duals
+        if has_lower_bound(x) && has_lower_bound(y)
+            set_dual_start_value(LowerBoundRef(y), dual(LowerBoundRef(x)))
+            num_starts += 1
+        end
+        if has_upper_bound(x) && has_upper_bound(y)
+            set_dual_start_value(UpperBoundRef(y), dual(UpperBoundRef(x)))
+            num_starts += 1
+        end
+    end
+    return num_starts
+end
+
+function transfer_start!(y::ConstraintRef, x::ConstraintRef, with_duals::Bool)
+    with_duals || return 0
+    set_dual_start_value(y, dual(x))
+    return 1
+end
+
+# Expressions and objects of different kinds carry no solution
+transfer_start!(y, x, with_duals::Bool) = 0
+
+"""
+Start values of the variables that only the JCC model has: the reserve mismatch of each (t, s),
+evaluated at the start values of the reserves.
+"""
+function complete_start_values!(model::Model, problem::AutarkyProblem, formulation::JCC)
+    reserve_mismatch = model[:reserve_mismatch]
+    start(x) = something(start_value(x), 0.0)
+    for s in 1:problem.S, t in 1:horizon(problem, formulation)
+        set_start_value(reserve_mismatch[t, s], value(start, reserve_supply(model, problem, t, s)) - problem.load[t, s])
+    end
+    return model
+end
+
+"""
+Solve the ICC model of a problem in-process and start a built JCC model from its primal and dual solution.
+
+The Ipopt warm-start options are kept in `model.ext[:solver_options]` and set when the JCC optimizer
+is attached.
+
+# Arguments:
+- `model::Model`: JCC model returned by `build_model(problem, formulation)`.
+- `problem::AutarkyProblem`: The project data.
+- `formulation::JCC`: The JCC formulation the model was built with.
+- `settings::PipelineSettings`: The warm-start settings.
+
+# Returns:
+- `icc_model::Union{Model, Nothing}`: The solved ICC model (nothing without warm start).
+"""
+function warm_start_from_icc!(model::Model, problem::AutarkyProblem, formulation::JCC, settings::PipelineSettings)
+    settings.warm_start == "icc" || return nothing
+
+    println("\nSolving the ICC model for the JCC warm start...")
+    icc = ICC(problem)
+    icc_model = build_model(problem, icc)
+    solve_model!(icc_model, problem, icc)
+
+    num_starts = transfer_solution!(model, icc_model)
+    complete_start_values!(model, problem, formulation)
+    model.ext[:solver_options] = settings.ipopt_warm_start_options
+    println("JCC model warm-started from the ICC solution ($num_starts primal and dual start values).")
+    return icc_model
+end
@@ -0,0 +1,451 @@
+# ------------------------------
+# PROBLEM DATA
+# ------------------------------
+
+"""
+Techno-economic parameters of a renewable technology (solar PV or wind turbine).
+
+# Fields:
+- `enabled::Bool`: Technology included in the system.
+- `allow_units::Bool`: Integer number of units of nominal capacity.
+- `capex::Float64`: Specific investment cost per kW.
+- `opex::Float64`: Fixed O&M cost as annual share of investment cost.
+- `subsidy_share::Float64`: Subsidy as a share of investment cost.
+- `lifetime::Int`: Lifetime in years.
+- `nominal_capacity::Float64`: Nominal capacity of one unit in kW.
+"""
+struct RenewableParameters
+    enabled::Bool
+    allow_units::Bool
+    capex::Float64
+    opex::Float64
+    subsidy_share::Float64
+    lifetime::Int
+    nominal_capacity::Float64
+end
+
+"""
+Techno-economic parameters of the battery bank.
+
+# Fields:
+- `enabled::Bool`, `allow_units::Bool`: As for `RenewableParameters`.
+- `nominal_capacity::Float64`: Nominal capacity of one unit in kWh.
+- `capex::Float64`, `opex::Float64`, `lifetime::Int`: Economics.
+- `η_charge::Float64`, `η_discharge::Float64`: Charging and discharging efficiencies.
+- `SOC_min::Float64`, `SOC_max::Float64`, `SOC_0::Float64`: State of charge bounds and initial value (shares of capacity).
+- `t_charge::Float64`, `t_discharge::Float64`: Charging and discharging times in hours.
+"""
+struct BatteryParameters
+    enabled::Bool
+    allow_units::Bool
+    nominal_capacity::Float64
+    capex::Float64
+    opex::Float64
+    lifetime::Int
+    η_charge::Float64
+    η_discharge::Float64
+    SOC_min::Float64
+    SOC_max::Float64
+    SOC_0::Float64
+    t_charge::Float64
+    t_discharge::Float64
+end
+
+"""
+Techno-economic parameters of the backup generator.
+
+# Fields:
+- `enabled::Bool`, `allow_units::Bool`: As for `RenewableParameters`.
+- `nominal_capacity::Float64`: Nominal capacity of one unit in kW.
+- `efficiency::Float64`: Nominal (full load) efficiency.
+- `allow_partial_load::Bool`: Piecewise-linear fuel consumption from the sampled efficiency curve.
+- `fuel_curve::String`: "hull" or "samples" (see `fuel_curve_segments`).
+- `capex::Float64`, `opex::Float64`, `lifetime::Int`: Economics.
+- `fuel_lhv::Float64`: Fuel lower heating value in kWh/l.
+- `fuel_cost::Float64`: Fuel cost per liter.
+- `fuel_consumption_limit::Bool`: Cap the annual fuel consumption.
+- `max_fuel_consumption::Float64`: Max annual fuel consumption in liters.
+- `sampled_relative_output::Vector{Float64}`, `sampled_efficiency::Vector{Float64}`: Samples of the efficiency curve (partial load only).
+"""
+struct GeneratorParameters
+    enabled::Bool
+    allow_units::Bool
+    nominal_capacity::Float64
+    efficiency::Float64
+    allow_partial_load::Bool
+    fuel_curve::String
+    capex::Float64
+    opex::Float64
+    lifetime::Int
+    fuel_lhv::Float64
+    fuel_cost::Float64
+    fuel_consumption_limit::Bool
+    max_fuel_consumption::Float64
+    sampled_relative_output::Vector{Float64}
+    sampled_efficiency::Vector{Float64}
+end
+
+"""
+National grid connection settings.
+
+# Fields:
+- `allow_connection::Bool`, `allow_export::Bool`: Grid import and export.
+- `max_line_capacity::Float64`: Capacity of the connection in kW.
+- `exchange_cost::Float64`: Cost of unsatisfied energy imported from the grid per kWh (uncertainty formulations).
+"""
+struct GridParameters
+    allow_connection::Bool
+    allow_export::Bool
+    max_line_capacity::Float64
+    exchange_cost::Float64
+end
+
+"""
+Outage and forecast error data of the uncertainty formulations.
+
+# Fields:
+- `enabled::Bool`: `uncertainty_settings` present in parameters.yaml (false for the deterministic inputs).
+- `outage_duration::Int`: Outage duration D in time steps.
+- `outage_probability::Float64`: Probability of a daily outage.
+- `islanding_probability::Float64`: Probability of successful islanding.
+- `reserve_formulation::String`: "rolling" or "explicit" SOC-under-reserve rows.
+- `errors_stddev::Vector{Vector{Float64}}`: Standard deviation of the combined load and solar errors of each season.
+- `errors_covariance::Vector{Matrix{Float64}}`: Covariance of the combined errors of each season.
+"""
+struct UncertaintyParameters
+    enabled::Bool
+    outage_duration::Int
+    outage_probability::Float64
+    islanding_probability::Float64
+    reserve_formulation::String
+    errors_stddev::Vector{Vector{Float64}}
+    errors_covariance::Vector{Matrix{Float64}}
+end
+
+"""
+Input data of an Autarky project: settings and technology parameters from parameters.yaml and
+the time series of the `inputs` folder. Time series are `Matrix{Float64}` of size (time steps, seasons);
+series of disabled technologies are empty.
+
+# Fields:
+- `parameters::Dict{Any, Any}`: The parameters.yaml content (used by the result writers).
+- `inputs_dir::String`: Folder of the inputs.
+- `currency::String`, `project_lifetime::Int`, `discount_factor::Vector{Float64}`, `Δt::Float64`: Project settings.
+- `operation_time_steps::Int`, `seasonality::Bool`, `num_seasons::Int`, `S::Int`, `season_weights::Dict{Int, Float64}`: Time series settings.
+- `max_capex::Float64`, `min_res_share::Float64`, `max_lost_load_share::Float64`: Optimization settings.
+- `grid`, `uncertainty`, `solar`, `wind`, `battery`, `generator`: Component parameters.
+- `load`, `solar_unit_production`, `wind_power`, `grid_cost`, `grid_availability`, `grid_price`: Time series.
+"""
+struct AutarkyProblem
+    parameters::Dict{Any, Any}
+    inputs_dir::String
+    currency::String
+    project_lifetime::Int
+    discount_factor::Vector{Float64}
+    Δt::Float64
+    operation_time_steps::Int
+    seasonality::Bool
+    num_seasons::Int
+    S::Int
+    season_weights::Dict{Int, Float64}
+    max_capex::Float64
+    min_res_share::Float64
+    max_lost_load_share::Float64
+    grid::GridParameters
+    uncertainty::UncertaintyParameters
+    solar::RenewableParameters
+    wind::RenewableParameters
+    battery::BatteryParameters
+    generator::GeneratorParameters
+    load::Matrix{Float64}
+    solar_unit_production::Matrix{Float64}
+    wind_power::Matrix{Float64}
+    grid_cost::Matrix{Float64}
+    grid_availability::Matrix{Float64}
+    grid_price::Matrix{Float64}
+end
+
+"""
+Replacement years of a component (whole years up to `project_lifetime - 1`).
+"""
+replacement_years(lifetime::Int, project_lifetime::Int) =
+    lifetime : lifetime : Int(floor((project_lifetime - 1) / lifetime) * lifetime)
+
+"""
+Share of the last installation of a component left at the end of the project.
+"""
+function salvage_fraction(lifetime::Int, project_lifetime::Int)
+    years = replacement_years(lifetime, project_lifetime)
+    last_install = isempty(years) ? 0 : maximum(years)
+    unused_life = lifetime - (project_lifetime - last_install)
+    return max(0.0, unused_life / lifetime)
+end
+
+read_time_series(path::String, num_seasons::Int, seasonality::Bool) =
+    Matrix{Float64}(import_time_series(path, num_seasons, seasonality))
+
+"""
+Path of a prediction errors file: `<name>_<s>.csv` with seasonality, `<name>.csv` (or `<name>_1.csv`) without.
+"""
+function errors_path(inputs_dir::String, name::String, s::Int, seasonality::Bool)
+    if seasonality
+        return joinpath(inputs_dir, "errors", "$(name)_$s.csv")
+    end
+    path = joinpath(inputs_dir, "errors", "$name.csv")
+    return isfile(path) ? path : joinpath(inputs_dir, "errors", "$(name)_1.csv")
+end
+
+"""
+Load the parameters and time series of a project.
+
+Solar and wind series are downloaded from PVGIS (and written back to the inputs folder) when
+`download_data` is set. The prediction errors are only read if parameters.yaml has `uncertainty_settings`.
+
+# Arguments:
+- `inputs_dir::String`: Folder with parameters.yaml, the time series CSV files and the `errors` folder.
+
+# Returns:
+- `problem::AutarkyProblem`: The project data.
+"""
+function load_problem(inputs_dir::String)
+    # Load project settings and parameters
+    parameters = YAML.load_file(joinpath(inputs_dir, "parameters.yaml"))
+
+    # Extract project settings
+    project_settings = parameters["project_settings"]
+    project_lifetime = Int(project_settings["project_lifetime"])
+    discount_rate = Float64(project_settings["discount_rate"])
+    latitude = project_settings["latitude"]
+    longitude = project_settings["longitude"]
+
+    # Extract time series settings
+    data_type = parameters["time_series_settings"]["data_type"]  # string
+    if data_type == "day"
+        operation_time_steps = 24  # Number of time steps in a day
+    elseif data_type == "week"
+        operation_time_steps = 24 * 7  # Number of time steps in a week
+    elseif data_type == "year"
+        operation_time_steps = 8760  # Number of time steps in a year
+    else
+        error("Invalid data type: $data_type. Supported types are 'day', 'week', and 'year'.")
+    end
+    # Calculate the scale factor for the time series data
+    year_scale_factor = 8760 / operation_time_steps
+
+    seasonality = parameters["time_series_settings"]["seasonality"]::Bool
+    num_seasons = Int(parameters["time_series_settings"]["num_seasons"])
+
+    if seasonality
+        if num_seasons == 1
+            error("Seasonality is enabled but `num_seasons` is set to 1. Please define multiple seasons.")
+        end
+
+        # Extract seasonal definition
+        seasonal_definition = parameters["time_series_settings"]["seasonal_definition"]
+
+        # Validate that all months (1-12) are accounted for
+        assigned_months = reduce(vcat, values(seasonal_definition))  # Flatten month lists
+        if sort(unique(assigned_months)) != collect(1:12)
+            error("Invalid seasonal definition: All months (1-12) must be assigned to a season exactly once.")
+        end
+
+        # Validate consistency of num_seasons with user-defined seasons
+        if length(seasonal_definition) != num_seasons
+            error("Mismatch between `num_seasons` and the number of defined seasonal groups in `seasonal_definition`.")
+        end
+        # Calculate seasonal scale factors (weights sum to `year_scale_factor`)
+        season_weights = Dict{Int, Float64}(s => (length(seasonal_definition[s]) / 12) * year_scale_factor for s in 1:num_seasons)
+    else
+        # If seasonality is not enabled, set a single season with the full year scale factor
+        seasonal_definition = Dict(1 => collect(1:12))
+        season_weights = Dict{Int, Float64}(1 => year_scale_factor)
+        num_seasons = 1
+    end
+
+    # Extract optimization settings
+    optimization_settings = parameters["optimization_settings"]
+    on_grid = optimization_settings["on_grid"]
+    grid = GridParameters(on_grid["allow_grid_connection"], on_grid["allow_grid_export"],
+                          on_grid["max_capacity"], get(on_grid, "grid_exchange_cost", 0.0))
+
+    # Extract uncertainty settings (uncertainty formulations only)
+    uncertainty_settings = get(parameters, "uncertainty_settings", nothing)
+    if uncertainty_settings === nothing
+        outage_duration = 0
+        outage_probability = 0.0
+        islanding_probability = 0.0
+        reserve_formulation = "rolling"
+    else
+        outage_duration = Int(uncertainty_settings["outage_duration"])
+        outage_probability = Float64(uncertainty_settings["outage_probability"])
+        islanding_probability = Float64(uncertainty_settings["islanding_probability"])
+        reserve_formulation = get(uncertainty_settings, "reserve_formulation", "rolling") # string
+        if !(reserve_formulation in ("rolling", "explicit"))
+            error("Invalid reserve formulation: $reserve_formulation. Supported formulations are 'rolling' and 'explicit'.")
+        end
+    end
+
+    # Extract technology parameters
+    solar_settings = parameters["solar_pv"]
+    solar = RenewableParameters(solar_settings["enabled"], solar_settings["allow_units"],
+                                solar_settings["economics"]["capex"], solar_settings["economics"]["opex"],
+                                solar_settings["economics"]["subsidy"], solar_settings["economics"]["lifetime"],
+                                solar_settings["technical"]["nominal_capacity"])
+
+    wind_settings = parameters["wind_turbine"]
+    wind = RenewableParameters(wind_settings["enabled"], wind_settings["allow_units"],
+                               wind_settings["economics"]["capex"], wind_settings["economics"]["opex"],
+                               wind_settings["economics"]["subsidy"], wind_settings["economics"]["lifetime"],
+                               wind_settings["technical"]["nominal_capacity"])
+
+    battery_settings = parameters["battery"]
+    battery = BatteryParameters(battery_settings["enabled"], battery_settings["allow_units"], battery_settings["nominal_capacity"],
+                                battery_settings["economics"]["capex"], battery_settings["economics"]["opex"],
+                                battery_settings["economics"]["lifetime"],
+                                battery_settings["efficiency"]["charge"], battery_settings["efficiency"]["discharge"],
+                                battery_settings["SOC"]["min"], battery_settings["SOC"]["max"], battery_settings["SOC"]["initial"],
+                                battery_settings["operation"]["charge_time"], battery_settings["operation"]["discharge_time"])
+
+    generator_settings = parameters["generator"]
+    fuel_curve = get(generator_settings, "fuel_curve", "hull") # string
+    if !(fuel_curve in ("hull", "samples"))
+        error("Invalid fuel curve formulation: $fuel_curve. Supported formulations are 'hull' and 'samples'.")
+    end
+    allow_partial_load = generator_settings["allow_partial_load"]::Bool
+    sampled_relative_output = Float64[]
+    sampled_efficiency = Float64[]
+    if generator_settings["enabled"] && allow_partial_load
+        println("\nLoading generator efficiency curve from CSV file...")
+        generator_efficiency_curve = CSV.read(joinpath(inputs_dir, "generator_efficiency_curve.csv"), DataFrame)
+        # Sample the efficiency curve for piece-wise linear interpolation
+        relative_output, efficiency = sample_efficiency_curve(generator_efficiency_curve, generator_settings["n_samples"])
+        sampled_relative_output = Vector{Float64}(relative_output)
+        sampled_efficiency = Vector{Float64}(efficiency)
+    end
+    generator = GeneratorParameters(generator_settings["enabled"], generator_settings["allow_units"],
+                                    generator_settings["nominal_capacity"], generator_settings["nominal_efficiency"],
+                                    allow_partial_load, fuel_curve,
+                                    generator_settings["economics"]["capex"], generator_settings["economics"]["opex"],
+                                    generator_settings["economics"]["lifetime"],
+                                    generator_settings["fuel"]["fuel_lhv"], generator_settings["fuel"]["fuel_cost"],
+                                    generator_settings["fuel"]["fuel_consumption_limit"], generator_settings["fuel"]["max_fuel_consumption"],
+                                    sampled_relative_output, sampled_efficiency)
+
+    # ------------------------------------
+    # LOAD AND INITIALIZE TIME SERIES DATA
+    # ------------------------------------
+
+    # Load demand data
+    println("\nLoading load data from CSV file...")
+    load = read_time_series(joinpath(inputs_dir, "load.csv"), num_seasons, seasonality)
+
+    # Load solar power data
+    solar_unit_production = zeros(0, 0)
+    if solar.enabled
+        if solar_settings["download_data"] == true
+            # Load and estimate solar power output from PVGIS data
+            pvgis_url = SolarPVGIS.build_pvgis_url(latitude, longitude)
+            println("\nDownloading solar data from PVGIS API...")
+            solar_pvgis_data = SolarPVGIS.estimate_solar_power(pvgis_url, latitude, longitude, solar_settings["technical"]) # Yearly data, hourly resolution
+            if seasonality
+                # Extract representative periods for each season based on clustering
+                solar_production_df = cluster_representative_periods(solar_pvgis_data, operation_time_steps, seasonal_definition) #TODO: adapt to the extra outage hours
+                println("Cluster Solar data over-written to CSV file.")
+            else
+                # Compute the average typical period
+                solar_production_df = compute_average_typical_period(solar_pvgis_data, operation_time_steps) #TODO: adapt to the extra outage hours
+                println("Average Solar data over-written to CSV file.")
+            end
+            CSV.write(joinpath(inputs_dir, "solar_production.csv"), solar_production_df)
+            solar_unit_production = Matrix{Float64}(solar_production_df)
+        else
+            # Load solar power output data from a CSV file
+            println("\nLoading solar data from CSV file...")
+            solar_unit_production = read_time_series(joinpath(inputs_dir, "solar_production.csv"), num_seasons, seasonality)
+        end
+    end
+
+    # Load wind power data
+    wind_power = zeros(0, 0)
+    if wind.enabled
+        if wind_settings["download_data"] == true
+            # Load and estimate wind power output from PVGIS data
+            pvgis_url = WindPVGIS.build_pvgis_url(latitude, longitude)
+            println("\nDownloading wind data from PVGIS API...")
+            wind_power_curve_path = joinpath(inputs_dir, "wind_power_curve.csv")
+            wind_pvgis_data, Cp = WindPVGIS.estimate_wind_power(pvgis_url, wind_settings["technical"], wind_power_curve_path)
+            if seasonality
+                # Extract representative periods for each season based on clustering
+                wind_production_df = cluster_representative_periods(wind_pvgis_data, operation_time_steps, seasonal_definition)
+                println("Cluster Wind data over-written to CSV file.")
+            else
+                # Compute the average typical period
+                wind_production_df = compute_average_typical_period(wind_pvgis_data, operation_time_steps)
+                println("Average Wind data over-written to CSV file.")
+            end
+            CSV.write(joinpath(inputs_dir, "wind_production.csv"), wind_production_df)
+            wind_power = Matrix{Float64}(wind_production_df)
+        else
+            println("\nLoading wind data from CSV file...")
+            wind_power = read_time_series(joinpath(inputs_dir, "wind_production.csv"), num_seasons, seasonality)
+        end
+    end
+
+    # Load grid cost and price data (if applicable)
+    if grid.allow_connection
+        println("\nLoading grid cost data from CSV file...")
+        grid_cost = read_time_series(joinpath(inputs_dir, "grid_cost.csv"), num_seasons, seasonality)
+        println("\nLoading grid availability data from CSV file...")
+        grid_availability = read_time_series(joinpath(inputs_dir, "grid_availability.csv"), num_seasons, seasonality)
+        grid_price = zeros(0, 0)
+        if grid.allow_export
+            println("\nLoading grid price data from CSV file...")
+            grid_price = read_time_series(joinpath(inputs_dir, "grid_price.csv"), num_seasons, seasonality)
+        end
+    else
+        # If not connected to the grid, set grid data to zero
+        grid_cost = zeros(operation_time_steps + outage_duration, num_seasons)
+        grid_availability = zeros(operation_time_steps + outage_duration, num_seasons)
+        grid_price = zeros(operation_time_steps + outage_duration, num_seasons)
+    end
+
+    # --------------------------------------------
+    # INITIALIZE ERRORS DATA AND COVARIANCE MATRIX
+    # --------------------------------------------
+
+    errors_stddev = Vector{Float64}[]
+    errors_covariance = Matrix{Float64}[]
+    if uncertainty_settings !== nothing
+        println("\nProcessing prediction errors", seasonality ? " with seasonality..." : " without seasonality...")
+        for s in 1:num_seasons
+            label = seasonality ? " Season $s" : ""
+            load_errors = CSV.read(errors_path(inputs_dir, "load_errors", s, seasonality), DataFrame)
+            solar_errors = CSV.read(errors_path(inputs_dir, "solar_errors", s, seasonality), DataFrame)
+
+            # Calculate covariance matrices
+            load_cov_matrix = ensure_positive_semidefinite(cov(Matrix{Float64}(load_errors); dims=2), "Load$label")
+            solar_cov_matrix = ensure_positive_semidefinite(cov(Matrix{Float64}(solar_errors); dims=2), "Solar$label")
+
+            # Combine errors covariance assuming independence
+            errors_cov_matrix = ensure_positive_semidefinite(load_cov_matrix + solar_cov_matrix, "Multi-variate$label")
+
+            # Standard deviation vector (the errors are assumed unbiased, with zero mean)
+            push!(errors_stddev, diag(errors_cov_matrix).^0.5)
+            push!(errors_covariance, errors_cov_matrix)
+        end
+        println("\nFinished processing prediction errors.")
+    end
+    uncertainty = UncertaintyParameters(uncertainty_settings !== nothing, outage_duration, outage_probability,
+                                        islanding_probability, reserve_formulation, errors_stddev, errors_covariance)
+
+    # Calculate the yearly discount factor
+    discount_factor = [1 / ((1 + discount_rate) ^ y) for y in 1:project_lifetime]
+
+    return AutarkyProblem(parameters, inputs_dir, string(project_settings["currency"]), project_lifetime, discount_factor,
+                          project_settings["time_step_duration"], operation_time_steps, seasonality, num_seasons,
+                          seasonality ? num_seasons : 1, season_weights,
+                          optimization_settings["max_capex"], optimization_settings["min_res_share"],
+                          get(optimization_settings, "max_lost_load_share", 0.0),
+                          grid, uncertainty, solar, wind, battery, generator,
+                          load, solar_unit_production, wind_power, grid_cost, grid_availability, grid_price)
+end
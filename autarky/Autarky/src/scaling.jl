@@ -0,0 +1,136 @@
+# ========================
+# PROBLEM SCALING
+# ========================
+
+"""
+Settings of the scaling stage of the model build (`scaling_settings` of parameters.yaml).
+
+# Fields:
+- `enabled::Bool`: Scale the objective and the linear rows of the built model.
+"""
+struct ScalingSettings
+    enabled::Bool
+end
+
+ScalingSettings(parameters::Dict) = ScalingSettings(get(get(parameters, "scaling_settings", Dict()), "enabled", false))
+
+# Power of two nearest to x: scaling by it is exact in floating point
+power_of_two(x::Float64) = exp2(round(log2(x)))
+
+"""
+Scale of the objective: the investment cost of the largest unit (capex × nominal capacity), which sets
+the magnitude of the NPC coefficients of the sizing variables.
+"""
+function objective_scale(problem::AutarkyProblem)
+    unit_costs = [component.capex * component.nominal_capacity
+                  for component in (problem.solar, problem.wind, problem.battery, problem.generator)
+                  if component.enabled && component.capex * component.nominal_capacity > 0]
+    return isempty(unit_costs) ? 1.0 : power_of_two(maximum(unit_costs))
+end
+
+objective_scale(model::Model) = get(model.ext, :objective_scale, 1.0)
+
+"""
+Factor of a scaled linear row (1 for the rows left unscaled).
+"""
+row_scale(model::Model, con::ConstraintRef) = get(get(model.ext, :row_scale, Dict()), con, 1.0)
+
+"""
+Change a coefficient or a right-hand side of a linear row, given in the units of the unscaled row.
+"""
+set_scaled_coefficient(model::Model, con::ConstraintRef, x::VariableRef, value::Float64) =
+    set_normalized_coefficient(con, x, row_scale(model, con) * value)
+
+set_scaled_rhs(model::Model, con::ConstraintRef, value::Float64) =
+    set_normalized_rhs(con, row_scale(model, con) * value)
+
+"""
+Dual of a row in the units of the unscaled model (NPC per unit of the row).
+"""
+unscaled_dual(model::Model, con::ConstraintRef) = dual(con) * objective_scale(model) * row_scale(model, con)
+
+# Linear rows with a scalar right-hand side (interval rows are left unscaled)
+const ScalableRow = ConstraintRef{Model, <:MOI.ConstraintIndex{<:MOI.ScalarAffineFunction,
+                                                               <:Union{MOI.EqualTo, MOI.GreaterThan, MOI.LessThan}}}
+
+"""
+Magnitude range (smallest and largest nonzero absolute value) of the matrix, right-hand side,
+bound and objective coefficients of a model. Their ratios bound the conditioning of the linear rows.
+"""
+function coefficient_ranges(model::Model)
+    ranges = Dict(name => [Inf, 0.0] for name in ("matrix", "rhs", "bounds", "objective"))
+    record!(name, v) = if v != 0 && isfinite(v)
+        ranges[name][1] = min(ranges[name][1], abs(v))
+        ranges[name][2] = max(ranges[name][2], abs(v))
+    end
+    for (F, S) in list_of_constraint_types(model)
+        F <: GenericAffExpr || continue
+        for con in all_constraints(model, F, S)
+            foreach(a -> record!("matrix", a), values(constraint_object(con).func.terms))
+            con isa ScalableRow && record!("rhs", normalized_rhs(con))
+        end
+    end
+    for x in all_variables(model)
+        has_lower_bound(x) && record!("bounds", lower_bound(x))
+        has_upper_bound(x) && record!("bounds", upper_bound(x))
+    end
+    foreach(a -> record!("objective", a), values(objective_function(model, AffExpr).terms))
+    return ranges
+end
+
+function print_coefficient_ranges(ranges::Dict, title::String)
+    println(title)
+    for name in ("matrix", "rhs", "bounds", "objective")
+        low, high = ranges[name]
+        if high > 0
+            println("  $(rpad(name, 10)) [$(round(low; sigdigits=2)), $(round(high; sigdigits=2))]  ",
+                    "ratio $(round(high / low; sigdigits=2))")
+        end
+    end
+end
+
+"""
+Scale a built model: the objective is divided by the investment cost of the largest unit and every
+named linear row (energy balances, state-of-charge rows, limits, CAPEX cap, ...) is multiplied by the
+power of two nearest to the inverse geometric mean of its coefficient magnitudes. Variables keep their
+units, so primal values and cost expressions need no unscaling; objective values and duals do
+(`objective_scale`, `unscaled_dual`). The factors are kept in `model.ext` for the in-place updates of
+sweeps (`set_scaled_coefficient`, `set_scaled_rhs`). Anonymous rows (tangent cuts) and nonlinear
+rows are left unscaled.
+
+# Arguments:
+- `model::Model`: Model built by `build_model`.
+- `problem::AutarkyProblem`: The project data.
+- `settings::ScalingSettings`: The scaling settings.
+"""
+function scale_model!(model::Model, problem::AutarkyProblem, settings::ScalingSettings)
+    settings.enabled || return model
+    before = coefficient_ranges(model)
+
+    # Objective
+    model.ext[:objective_scale] = objective_scale(problem)
+    @objective(model, Min, model[:NPC] / objective_scale(model))
+
+    # Named linear rows
+    row_factors = Dict{ConstraintRef, Float64}()
+    for object in values(object_dictionary(model))
+        for con in (object isa AbstractArray ? object : (object,))
+            con isa ScalableRow || continue
+            magnitudes = [abs(a) for a in values(constraint_object(con).func.terms) if a != 0]
+            isempty(magnitudes) && continue
+            factor = power_of_two(1 / sqrt(minimum(magnitudes) * maximum(magnitudes)))
+            factor == 1 && continue
+            for (x, a) in constraint_object(con).func.terms
+                set_normalized_coefficient(con, x, factor * a)
+            end
+            set_normalized_rhs(con, factor * normalized_rhs(con))
+            row_factors[con] = factor
+        end
+    end
+    model.ext[:row_scale] = row_factors
+
+    print_coefficient_ranges(before, "\nCoefficient ranges before scaling:")
+    print_coefficient_ranges(coefficient_ranges(model), "Coefficient ranges after scaling " *
+                             "(objective / $(objective_scale(model)), $(length(row_factors)) rows scaled):")
+    return model
+end
@@ -0,0 +1,146 @@
+module ShortfallCuts
+
+using JuMP
+using Distributions: Normal, pdf, cdf, quantile
+
+"""
+Expected shortfall penalty of one time step and season, ψ(y) = c σ g(y/σ) with the standard normal
+loss function g(z) = φ(z) + z Φ(z).
+
+ψ is convex in y, so its epigraph is the intersection of its tangent half-spaces
+expected_shortfall ≥ c (σ φ(z) + Φ(z) y) for all z, and any finite subset of them is a linear
+outer approximation. With a positive penalty in the objective the shortfall variable sits on the
+approximation at the optimum.
+
+# Fields:
+- `shortfall::VariableRef`: Expected shortfall variable of (t, s).
+- `mismatch::VariableRef`: Energy mismatch y[t, s].
+- `c::Float64`: Penalty cost of (t, s).
+- `σ::Float64`: Standard deviation of the load errors at (t, s).
+- `cuts::Vector{ConstraintRef}`: Cuts of the term.
+- `points::Vector{Float64}`: Standardized tangent point of each cut (Inf for the asymptote ψ ≥ c y).
+"""
+mutable struct ShortfallTerm
+    shortfall::VariableRef
+    mismatch::VariableRef
+    c::Float64
+    σ::Float64
+    cuts::Vector{ConstraintRef}
+    points::Vector{Float64}
+end
+
+ShortfallTerm(shortfall::VariableRef, mismatch::VariableRef, c::Float64, σ::Float64) =
+    ShortfallTerm(shortfall, mismatch, c, σ, ConstraintRef[], Float64[])
+
+"""
+Exact penalty ψ(y) of a term (c max(y, 0) without uncertainty).
+"""
+function shortfall_value(term::ShortfallTerm, y::Float64)
+    if term.σ <= 0
+        return term.c * max(y, 0.0)
+    end
+    z = y / term.σ
+    return term.c * term.σ * (pdf(Normal(), z) + z * cdf(Normal(), z))
+end
+
+"""
+Tangent points of the initial approximation: `n` quantiles of the standard normal, which
+concentrate the cuts around z = 0 where g bends the most.
+"""
+tangent_points(n::Int) = [quantile(Normal(), k / (n + 1)) for k in 1:n]
+
+"""
+Add the tangent cut of a term at the standardized mismatch `z` (z = Inf gives the asymptote ψ ≥ c y).
+"""
+function add_tangent_cut!(model::Model, term::ShortfallTerm, z::Float64)
+    cut = @constraint(model, term.shortfall >= term.c * (term.σ * pdf(Normal(), z) + cdf(Normal(), z) * term.mismatch))
+    push!(term.cuts, cut)
+    push!(term.points, z)
+    return cut
+end
+
+"""
+Change the penalty cost of a term in place: every cut is scaled by c, so only its mismatch
+coefficient and its right-hand side change.
+"""
+function set_shortfall_cost!(term::ShortfallTerm, c::Float64)
+    term.c = c
+    for (cut, z) in zip(term.cuts, term.points)
+        set_normalized_coefficient(cut, term.mismatch, -c * cdf(Normal(), z))
+        set_normalized_rhs(cut, c * term.σ * pdf(Normal(), z))
+    end
+    return term
+end
+
+"""
+Build the initial outer approximation: the asymptote ψ(y) ≥ c y and `n` tangent cuts per term
+(the asymptote ψ ≥ 0 is the lower bound of the shortfall variable).
+
+# Arguments:
+- `model::Model`: The JuMP model.
+- `terms::Vector{ShortfallTerm}`: Expected shortfall terms of all time steps and seasons.
+- `n::Int`: Number of tangent cuts per term.
+
+# Returns:
+- `num_cuts::Int`: Number of linear constraints added.
+"""
+function add_shortfall_cuts!(model::Model, terms::Vector{ShortfallTerm}, n::Int)
+    points = tangent_points(n)
+    num_cuts = 0
+    for term in terms
+        add_tangent_cut!(model, term, Inf)
+        num_cuts += 1
+        # Without uncertainty ψ is the piecewise-linear max(c y, 0) and needs no tangents
+        term.σ > 0 || continue
+        for z in points
+            add_tangent_cut!(model, term, z)
+            num_cuts += 1
+        end
+    end
+    return num_cuts
+end
+
+"""
+Cutting-plane refinement of the outer approximation.
+
+After each solve, every term whose approximation error ψ(y*) - shortfall* exceeds `tolerance`
+(relative to max(1, ψ(y*))) gets a tangent cut at its current mismatch, and the model is re-solved
+(the LP solvers warm-start from the previous basis). Stops when no cut is added or after `iterations` rounds.
+
+# Arguments:
+- `model::Model`: The JuMP model, already solved once.
+- `terms::Vector{ShortfallTerm}`: Expected shortfall terms of all time steps and seasons.
+
+# Keyword Arguments:
+- `iterations::Int`: Maximum number of refinement rounds.
+- `tolerance::Float64`: Relative approximation error under which a term is accepted.
+
+# Returns:
+- `num_cuts::Int`: Number of cuts added by the refinement.
+"""
+function refine_shortfall_cuts!(model::Model, terms::Vector{ShortfallTerm}; iterations::Int = 10, tolerance::Float64 = 1e-4)
+    num_cuts = 0
+    for iteration in 1:iterations
+        has_values(model) || break
+        added = 0
+        max_gap = 0.0
+        for term in terms
+            term.σ > 0 || continue
+            y = value(term.mismatch)
+            exact = shortfall_value(term, y)
+            gap = exact - value(term.shortfall)
+            max_gap = max(max_gap, gap / max(1.0, exact))
+            if gap > tolerance * max(1.0, exact)
+                add_tangent_cut!(model, term, y / term.σ)
+                added += 1
+            end
+        end
+        println("Expected shortfall refinement $iteration: largest relative gap $(round(max_gap, sigdigits=3)), $added cuts added.")
+        added == 0 && break
+        num_cuts += added
+        optimize!(model)
+    end
+    return num_cuts
+end
+
+end # module ShortfallCuts
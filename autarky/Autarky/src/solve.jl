@@ -0,0 +1,165 @@
+# ========================
+# SOLVING THE MODEL
+# ========================
+
+"""
+Solver backend of a formulation: `solver_settings.solver` of parameters.yaml, or `default` without it.
+"""
+model_solver(problem::AutarkyProblem, default::String) = get(problem.parameters["solver_settings"], "solver", default)
+
+"""
+Ipopt optimizer with the `ipopt_options` block of parameters.yaml, for the formulations with nonlinear rows.
+"""
+function ipopt_optimizer(problem::AutarkyProblem, name::String)
+    solver = model_solver(problem, "ipopt")
+    if solver != "ipopt"
+        error("Invalid solver for the nonlinear $name formulation: $solver. Supported solver is 'ipopt'.")
+    end
+    # HSL linear solvers need a functional HSL library (MUMPS otherwise)
+    optimizer = solver_optimizer(solver, problem.parameters["solver_settings"])
+    ipopt_options = get(problem.parameters["solver_settings"], "ipopt_options", Dict())
+    return set_linear_solver!(optimizer, get(ipopt_options, "linear_solver", "mumps"), LinearSolverSettings(problem.parameters),
+                              ipopt_options)
+end
+
+"""
+Optimizer of a formulation, configured from the `solver_settings` of parameters.yaml.
+"""
+function model_optimizer(problem::AutarkyProblem, ::Deterministic)
+    # LP/MILP: any backend (Gurobi unless `solver` says otherwise)
+    solver = model_solver(problem, "gurobi")
+    if solver == "ipopt" && any(component.enabled && component.allow_units for component in (problem.solar, problem.wind, problem.battery, problem.generator))
+        error("Invalid solver for integer sizing (allow_units): ipopt. Supported solvers are 'highs', 'gurobi' and 'glpk'.")
+    end
+    solver == "ipopt" && return ipopt_optimizer(problem, "Deterministic")
+    return solver_optimizer(solver, problem.parameters["solver_settings"])
+end
+
+function model_optimizer(problem::AutarkyProblem, formulation::Union{ExpectedValues, ICC})
+    if formulation.shortfall.formulation == "nonlinear"
+        return ipopt_optimizer(problem, formulation isa ICC ? "ICC" : "Expected Value")
+    end
+    # The outer approximation is linear: LP/MILP solver
+    return lp_optimizer(formulation.shortfall.lp_solver, problem.parameters["solver_settings"])
+end
+
+function model_optimizer(problem::AutarkyProblem, formulation::JCC)
+    optimizer = ipopt_optimizer(problem, "JCC")
+    # Without JCC Hessians Ipopt builds a quasi-Newton (L-BFGS) approximation of the Lagrangian Hessian
+    if formulation.settings.hessian == "quasi-newton"
+        set_optimizer_attribute(optimizer, "hessian_approximation", "limited-memory")
+    end
+    return optimizer
+end
+
+"""
+Solver hooks of a formulation: `prepare_solve!` runs before `optimize!`, `finish_solve!` right after it
+and `check_solution` once the termination status is known.
+"""
+prepare_solve!(model::Model, problem::AutarkyProblem, ::Formulation) = nothing
+finish_solve!(model::Model, problem::AutarkyProblem, ::Formulation) = nothing
+check_solution(model::Model, problem::AutarkyProblem, ::Formulation) = nothing
+
+function finish_solve!(model::Model, problem::AutarkyProblem, formulation::Union{ExpectedValues, ICC})
+    settings = formulation.shortfall
+    if settings.formulation == "tangent_cuts" && settings.refinement_iterations > 0
+        @time refine_shortfall_cuts!(model, model.ext[:shortfall_terms]; iterations=settings.refinement_iterations,
+                                     tolerance=settings.refinement_tolerance)
+    end
+end
+
+function prepare_solve!(model::Model, problem::AutarkyProblem, formulation::JCC)
+    settings = formulation.settings
+    # Adaptive JCC accuracy driven by Ipopt's intermediate callback
+    if settings.adaptive
+        jcc = model.ext[:jcc]
+        schedule = AccuracySchedule(jcc.store, jcc.caches, settings.adaptive_samples, settings.adaptive_tolerances)
+        MOI.set(model, Ipopt.CallbackFunction(), accuracy_callback(schedule))
+        println("Adaptive JCC accuracy enabled: $(settings.adaptive_samples) points per shift.")
+    end
+end
+
+finish_solve!(model::Model, problem::AutarkyProblem, ::JCC) = report_cache_usage(model.ext[:jcc].caches)
+
+function check_solution(model::Model, problem::AutarkyProblem, formulation::JCC)
+    # High-accuracy check of the joint chance constraints at the final point
+    if has_values(model)
+        jcc = model.ext[:jcc]
+        D = problem.uncertainty.outage_duration
+        reserve_mismatch = model[:reserve_mismatch]
+        points = [value.(reserve_mismatch[τ:τ+D, s]) for (τ, s) in jcc.window_starts]
+        verify_windows(jcc.store, jcc.windows, points, problem.uncertainty.islanding_probability;
+                       samples=formulation.settings.verify_samples, threaded=formulation.settings.threaded)
+    end
+end
+
+"""
+Attach the optimizer of a formulation to a model, with the solver options kept in
+`model.ext[:solver_options]` by the warm-start pipeline (see `warm_start_from_icc!`).
+With `linear_solver_settings.benchmark`, the Ipopt linear solver is the fastest candidate on the model.
+"""
+function attach_optimizer!(model::Model, problem::AutarkyProblem, formulation::Formulation)
+    set_optimizer(model, model_optimizer(problem, formulation))
+    for (key, value) in get(model.ext, :solver_options, Dict())
+        set_attribute(model, key, value)
+    end
+    settings = LinearSolverSettings(problem.parameters)
+    if settings.benchmark && solver_name(model) == "Ipopt"
+        if hsl_functional()
+            benchmark_linear_solvers!(model, problem, formulation, settings)
+        else
+            println("Warning: the HSL library is not functional, the linear solver benchmark is skipped.")
+        end
+    end
+    return model
+end
+
+"""
+Solve a model whose optimizer is attached: formulation hooks, `optimize!` and the solution check.
+
+# Returns:
+- `status`: Termination status of the solve.
+"""
+function optimize_model!(model::Model, problem::AutarkyProblem, formulation::Formulation)
+    prepare_solve!(model, problem, formulation)
+
+    # Solve the optimization problem
+    @time with_factor_files(() -> optimize!(model), model, problem)
+    finish_solve!(model, problem, formulation)
+    report_ma97_cache()
+    println(solution_summary(model))
+    if objective_scale(model) != 1 && has_values(model)
+        println("Unscaled objective value (NPC): ", objective_value(model) * objective_scale(model))
+    end
+
+    status = termination_status(model)
+    if status != MOI.INFEASIBLE
+        check_solution(model, problem, formulation)
+    end
+    return status
+end
+
+"""
+Attach the optimizer of a formulation to a built model and solve it.
+
+# Arguments:
+- `model::Model`: Model returned by `build_model(problem, formulation)`.
+- `problem::AutarkyProblem`: The project data.
+- `formulation::Formulation`: The formulation the model was built with.
+
+# Returns:
+- `status`: Termination status of the solve (an error is raised if the model is infeasible).
+"""
+function solve_model!(model::Model, problem::AutarkyProblem, formulation::Formulation)
+    # Attach the solver to the model
+    attach_optimizer!(model, problem, formulation)
+    status = optimize_model!(model, problem, formulation)
+
+    # Evaluate solution status
+    if status == MOI.INFEASIBLE
+        error("\nOptimization result: INFEASIBLE. The model has no feasible solution. Please check constraints and input parameters.")
+    else
+        println("\nOptimization completed with status: ", status)
+    end
+    return status
+end
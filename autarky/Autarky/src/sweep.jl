@@ -0,0 +1,280 @@
+# ========================
+# PARAMETRIC SWEEPS
+# ========================
+
+# Scalars that can be swept on a built model, with the formulations they act on. Each one is a
+# coefficient, a right-hand side or a nonlinear parameter of the model, so a new value only
+# updates the model in place (`update_model!`) and the next solve restarts from the previous point.
+const SWEEP_PARAMETERS = ("islanding_probability", "outage_probability", "fuel_cost", "grid_exchange_cost",
+                          "solar_capex", "wind_capex", "battery_capex", "generator_capex")
+
+sweep_parameters(::Deterministic) = ("fuel_cost", "solar_capex", "wind_capex", "battery_capex", "generator_capex")
+sweep_parameters(::ExpectedValues) = filter(!=("islanding_probability"), SWEEP_PARAMETERS)
+sweep_parameters(::Union{ICC, JCC}) = SWEEP_PARAMETERS
+
+"""
+Settings of a parametric sweep (`sweep_settings` of parameters.yaml).
+
+# Fields:
+- `enabled::Bool`: Solve the sweep instead of a single model.
+- `parameter::String`: Swept scalar (see `SWEEP_PARAMETERS`).
+- `values::Vector{Float64}`: Values of the parameter, solved in this order.
+- `warm_start::Bool`: Start each point from the primal (and, with Ipopt, dual) solution of the previous one.
+- `ipopt_warm_start_options::Dict{Any, Any}`: Ipopt options set from the second point on.
+"""
+struct SweepSettings
+    enabled::Bool
+    parameter::String
+    values::Vector{Float64}
+    warm_start::Bool
+    ipopt_warm_start_options::Dict{Any, Any}
+end
+
+function SweepSettings(parameters::Dict)
+    sweep_settings = get(parameters, "sweep_settings", Dict())
+    parameter = get(sweep_settings, "parameter", "islanding_probability") # string
+    if !(parameter in SWEEP_PARAMETERS)
+        error("Invalid sweep parameter: $parameter. Supported parameters are '$(join(SWEEP_PARAMETERS, "', '"))'.")
+    end
+    return SweepSettings(get(sweep_settings, "enabled", false), parameter,
+                         Vector{Float64}(get(sweep_settings, "values", Float64[])),
+                         get(sweep_settings, "warm_start", true),
+                         Dict{Any, Any}(get(sweep_settings, "ipopt_warm_start_options",
+                                            Dict("warm_start_init_point" => "yes"))))
+end
+
+"""
+Copy of a struct with one field replaced.
+"""
+replace_field(x::T, field::Symbol, value) where {T} =
+    T((name == field ? value : getfield(x, name) for name in fieldnames(T))...)
+
+"""
+Copy of a problem with a swept scalar set to `value`.
+"""
+function set_parameter(problem::AutarkyProblem, parameter::String, value::Float64)
+    if parameter in ("islanding_probability", "outage_probability")
+        return replace_field(problem, :uncertainty, replace_field(problem.uncertainty, Symbol(parameter), value))
+    elseif parameter == "fuel_cost"
+        return replace_field(problem, :generator, replace_field(problem.generator, :fuel_cost, value))
+    elseif parameter == "grid_exchange_cost"
+        return replace_field(problem, :grid, replace_field(problem.grid, :exchange_cost, value))
+    elseif parameter in ("solar_capex", "wind_capex", "battery_capex", "generator_capex")
+        technology = Symbol(first(split(parameter, "_")))
+        return replace_field(problem, technology, replace_field(getfield(problem, technology), :capex, value))
+    end
+    error("Invalid sweep parameter: $parameter. Supported parameters are '$(join(SWEEP_PARAMETERS, "', '"))'.")
+end
+
+"""
+Bring a built model in line with a problem that differs from the build data in `parameter` only.
+
+The islanding probability moves the ICC right-hand sides or the JCC nonlinear parameter, the exchange
+cost moves the expected shortfall parameter (or rescales the tangent cuts), and the capex values move
+the coefficients of the CAPEX cap. The cost expressions and the objective are rebuilt from the problem:
+they are linear in the variables and cheap next to the constraints, which are kept.
+
+# Arguments:
+- `model::Model`: Model returned by `build_model`.
+- `problem::AutarkyProblem`: The project data with the new parameter value.
+- `formulation::Formulation`: The formulation the model was built with.
+- `parameter::String`: The changed scalar.
+"""
+function update_model!(model::Model, problem::AutarkyProblem, formulation::Formulation, parameter::String)
+    if !(parameter in sweep_parameters(formulation))
+        error("Invalid sweep parameter: $parameter. Supported parameters of this formulation are '$(join(sweep_parameters(formulation), "', '"))'.")
+    end
+    T = horizon(problem, formulation)
+
+    if parameter == "islanding_probability"
+        update_islanding_probability!(model, problem, formulation, T)
+    elseif parameter == "grid_exchange_cost"
+        update_exchange_cost!(model, problem, formulation, T)
+    elseif endswith(parameter, "_capex")
+        technology = Symbol(first(split(parameter, "_")))
+        component = getfield(problem, technology)
+        if component.enabled
+            units = model[Symbol("$(technology)_units")]
+            set_scaled_coefficient(model, model[:capex_cap], units, component.nominal_capacity * component.capex)
+        end
+    end
+
+    # Cost expressions and objective
+    update_costs!(model, problem, formulation, T)
+    return model
+end
+
+function update_islanding_probability!(model::Model, problem::AutarkyProblem, ::ICC, T::Int)
+    z = quantile(Normal(), problem.uncertainty.islanding_probability)
+    energy_balance = model[:energy_balance]
+    for s in 1:problem.S, t in 1:T
+        set_scaled_rhs(model, energy_balance[t, s], problem.load[t, s] + z * problem.uncertainty.errors_stddev[s][t])
+    end
+end
+
+update_islanding_probability!(model::Model, problem::AutarkyProblem, ::JCC, T::Int) =
+    set_value(model.ext[:islanding_probability], problem.uncertainty.islanding_probability)
+
+function update_exchange_cost!(model::Model, problem::AutarkyProblem, formulation::UncertainFormulation, T::Int)
+    if shortfall_formulation(formulation) == "nonlinear"
+        set_value(model.ext[:grid_exchange_cost], problem.grid.exchange_cost)
+    else
+        # Terms are stored season by season, time step by time step (see `add_expected_shortfall!`)
+        terms = model.ext[:shortfall_terms]
+        for s in 1:problem.S, t in 1:T
+            set_shortfall_cost!(terms[(s - 1) * T + t], problem.grid_cost[t, s] + problem.grid.exchange_cost)
+        end
+    end
+end
+
+# Names registered by `add_costs!` (and by `add_operation_costs!` of each formulation)
+const COST_EXPRESSIONS = (:CAPEX, :Replacement_Cost_npv, :Subsidies, :OPEX_fixed, :Salvage_npv, :OPEX_npv, :NPC,
+                          :OPEX_variable, :core_operational_costs, :outage_costs, :non_outage_costs, :reserve_costs,
+                          :core_operational_costs_total, :Annual_Opex)
+
+function update_costs!(model::Model, problem::AutarkyProblem, formulation::Formulation, T::Int)
+    for name in COST_EXPRESSIONS
+        haskey(model, name) && unregister(model, name)
+    end
+    add_costs!(model, problem, formulation, T)
+    @objective(model, Min, model[:NPC] / objective_scale(model))
+    return model
+end
+
+"""
+Solution of a solved model kept as the start of the next solve: primal values, and for Ipopt the
+linear constraint and nonlinear block duals. Must be read before the model is modified.
+"""
+struct WarmStart
+    primal::Dict{VariableRef, Float64}
+    duals::Dict{ConstraintRef, Any}
+    nonlinear_duals::Vector{Float64}
+end
+
+function WarmStart(model::Model, with_duals::Bool)
+    primal = Dict(x => value(x) for x in all_variables(model))
+    duals = Dict{ConstraintRef, Any}()
+    nonlinear_duals = Float64[]
+    if with_duals && has_duals(model)
+        for (F, S) in list_of_constraint_types(model)
+            for con in all_constraints(model, F, S)
+                duals[con] = dual(con)
+            end
+        end
+        nonlinear_duals = dual.(all_nonlinear_constraints(model))
+    end
+    return WarmStart(primal, duals, nonlinear_duals)
+end
+
+function apply_warm_start!(model::Model, start::WarmStart)
+    for (x, v) in start.primal
+        # Integer sizing variables keep a feasible (rounded) start
+        set_start_value(x, is_integer(x) ? round(v) : v)
+    end
+    for (con, d) in start.duals
+        is_valid(model, con) && set_dual_start_value(con, d)
+    end
+    if !isempty(start.nonlinear_duals)
+        set_nonlinear_dual_start_value(model, start.nonlinear_duals)
+    end
+    return model
+end
+
+"""
+Ipopt solves the nonlinear formulations (and, here, only them).
+"""
+uses_ipopt(::Deterministic) = false
+uses_ipopt(formulation::Union{ExpectedValues, ICC}) = formulation.shortfall.formulation == "nonlinear"
+uses_ipopt(::JCC) = true
+
+"""
+Empty results table of a sweep over `parameter`: one row per point with the parameter value,
+termination status, solve time, NPC, CAPEX and installed units of each enabled technology.
+"""
+function sweep_table(problem::AutarkyProblem, parameter::String)
+    results = DataFrame(parameter => Float64[], "Status" => String[], "Solve Time [s]" => Float64[],
+                        "NPC" => Float64[], "CAPEX" => Float64[])
+    for technology in (:solar, :wind, :battery, :generator)
+        if getfield(problem, technology).enabled
+            results[!, "$(technology)_units"] = Float64[]
+        end
+    end
+    return results
+end
+
+"""
+Append the solution of a sweep point to its results table.
+"""
+function record_point!(results::DataFrame, model::Model, v::Float64, status)
+    solved = has_values(model)
+    row = Any[v, string(status), solve_time(model),
+              solved ? value(model[:NPC]) : NaN, solved ? value(model[:CAPEX]) : NaN]
+    for column in names(results)[6:end]
+        push!(row, solved ? value(model[Symbol(column)]) : NaN)
+    end
+    push!(results, row)
+    return results
+end
+
+function set_ipopt_options!(model::Model, options::Dict)
+    for (key, value) in options
+        set_attribute(model, key, value)
+    end
+end
+
+"""
+Solve a built model over a grid of values of one scalar, modifying the model in place between points.
+
+The optimizer is attached once. LP/MILP solvers keep their basis across the in-place modifications;
+with Ipopt every point starts from the primal and dual solution of the previous one
+(`ipopt_warm_start_options` are set from the second point on). The model holds the solution of the
+last point on return.
+
+# Arguments:
+- `model::Model`: Model returned by `build_model(problem, formulation)`.
+- `problem::AutarkyProblem`: The project data.
+- `formulation::Formulation`: The formulation the model was built with.
+- `settings::SweepSettings`: The swept parameter and its values.
+
+# Returns:
+- `results::DataFrame`: One row per point (see `sweep_table`).
+- `problem::AutarkyProblem`: The project data of the last point.
+"""
+function sweep_model!(model::Model, problem::AutarkyProblem, formulation::Formulation, settings::SweepSettings)
+    parameter = settings.parameter
+    if isempty(settings.values)
+        error("Invalid sweep values: the `values` of `sweep_settings` are empty.")
+    end
+    ipopt = uses_ipopt(formulation)
+    results = sweep_table(problem, parameter)
+
+    attach_optimizer!(model, problem, formulation)
+    for (k, v) in enumerate(settings.values)
+        println("\n------ Sweep point $k of $(length(settings.values)): $parameter = $v ------")
+        # Keep the previous solution before the model changes
+        start = settings.warm_start && k > 1 && has_values(model) ? WarmStart(model, ipopt) : nothing
+        problem = set_parameter(problem, parameter, v)
+        update_model!(model, problem, formulation, parameter)
+        if start !== nothing
+            apply_warm_start!(model, start)
+            if ipopt && k == 2
+                set_ipopt_options!(model, settings.ipopt_warm_start_options)
+            end
+        end
+
+        status = optimize_model!(model, problem, formulation)
+        println("\nSweep point completed with status: ", status)
+        record_point!(results, model, v, status)
+    end
+    return results, problem
+end
+
+"""
+Write the sweep results to `sweep_<parameter>.csv` in a results folder.
+"""
+function write_sweep_to_csv(results::DataFrame, results_dir::String, parameter::String)
+    mkpath(results_dir)
+    sweep_path = joinpath(results_dir, "sweep_$parameter.csv")
+    CSV.write(sweep_path, results)
+    println("Sweep results written to $sweep_path")
+end
@@ -4,6 +4,7 @@ using JuMP, CSV, DataFrames, YAML
 using Statistics, Clustering, Dates, Interpolations
 using Distributions, LinearAlgebra
 using HypothesisTests  # For Shapiro-Wilk test
+using HiGHS, GLPK, Gurobi, Ipopt
 
 """
 Load time series data from a CSV file and validate its structure based on seasonality settings.
@@ -181,6 +182,45 @@ function test_normality(errors::DataFrame, label::String)
 
 end
 
+"""
+Segments of the lower convex envelope of a sampled fuel consumption curve.
+
+Sampled points lying on or above the chord of their neighbours do not support the envelope: their
+segments only add redundant (or non-convex) cuts. The remaining slopes are strictly increasing, so
+the fuel consumption is the maximum of the segment lines, i.e. one epigraph cut per segment.
+
+# Arguments:
+- `power_points::Vector{Float64}`: Sampled output powers in increasing order.
+- `fuel_points::Vector{Float64}`: Fuel consumption at the sampled powers.
+
+# Returns:
+- `slopes::Vector{Float64}`, `intercepts::Vector{Float64}`: Segment k is fuel = slopes[k] * power + intercepts[k] (per unit of nominal capacity).
+"""
+function fuel_curve_segments(power_points::AbstractVector, fuel_points::AbstractVector)
+    # Monotone chain over the points sorted by power
+    hull = Int[]
+    for i in eachindex(power_points)
+        while length(hull) >= 2
+            a, b = hull[end-1], hull[end]
+            cross = (power_points[b] - power_points[a]) * (fuel_points[i] - fuel_points[a]) -
+                    (fuel_points[b] - fuel_points[a]) * (power_points[i] - power_points[a])
+            cross <= 0 || break
+            pop!(hull)  # b lies on or above the chord from a to i
+        end
+        push!(hull, i)
+    end
+
+    slopes = Float64[]
+    intercepts = Float64[]
+    for k in 1:(length(hull) - 1)
+        i, j = hull[k], hull[k+1]
+        slope = (fuel_points[j] - fuel_points[i]) / (power_points[j] - power_points[i])
+        push!(slopes, slope)
+        push!(intercepts, fuel_points[i] - slope * power_points[i])
+    end
+    return slopes, intercepts
+end
+
 """
 Checks if a covariance matrix is positive semi-definite (PSD) and regularizes it if necessary.
 # Positional Arguments:
@@ -213,4 +253,57 @@ function ensure_positive_semidefinite(covariance_matrix::Matrix{Float64}, label:
     return covariance_matrix
 end
 
+# Optimizer, option block of `solver_settings` and display name of each solver backend
+const SOLVERS = Dict("highs" => (HiGHS.Optimizer, "highs_options", "HiGHS"),
+                     "gurobi" => (Gurobi.Optimizer, "gurobi_options", "Gurobi"),
+                     "glpk" => (GLPK.Optimizer, "glpk_options", "GLPK"),
+                     "ipopt" => (Ipopt.Optimizer, "ipopt_options", "Ipopt"))
+
+"""
+HiGHS option value: `threads: "auto"` gives HiGHS every CPU thread (MIP search and parallel dual simplex;
+the IPX interior point solver is serial).
+"""
+highs_option(key, value) = key == "threads" && value == "auto" ? Sys.CPU_THREADS : value
+
+"""
+Build the optimizer of a solver backend with its option block from `solver_settings`.
+
+# Arguments:
+- `solver::String`: "highs", "gurobi", "glpk" or "ipopt".
+- `solver_settings::Dict`: The `solver_settings` section of parameters.yaml.
+
+# Returns:
+- `optimizer`: Optimizer factory to attach with `set_optimizer`.
+"""
+function solver_optimizer(solver::String, solver_settings::Dict)
+    if !haskey(SOLVERS, solver)
+        error("Invalid solver: $solver. Supported solvers are 'highs', 'gurobi', 'glpk' and 'ipopt'.")
+    end
+
+    optimizer_type, options_key, solver_name = SOLVERS[solver]
+    optimizer = optimizer_with_attributes(optimizer_type)
+    println("\nInitializing the solver ($solver_name)...")
+    for (key, value) in get(solver_settings, options_key, Dict())
+        set_optimizer_attribute(optimizer, key, solver == "highs" ? highs_option(key, value) : value)
+    end
+    return optimizer
+end
+
+"""
+Build a linear (or mixed-integer) programming optimizer with its option block from `solver_settings`.
+
+# Arguments:
+- `solver::String`: "highs", "gurobi" or "glpk".
+- `solver_settings::Dict`: The `solver_settings` section of parameters.yaml.
+
+# Returns:
+- `optimizer`: Optimizer factory to attach with `set_optimizer`.
+"""
+function lp_optimizer(solver::String, solver_settings::Dict)
+    if !(solver in ("highs", "gurobi", "glpk"))
+        error("Invalid LP solver: $solver. Supported solvers are 'highs', 'gurobi' and 'glpk'.")
+    end
+    return solver_optimizer(solver, solver_settings)
+end
+
 end # module Utils
\ No newline at end of file
@@ -1,8 +1,7 @@
 module PostProcessing
 
 using JuMP, CSV, DataFrames, Dates, Statistics
-include(joinpath(@__DIR__, "utils.jl"))
-using .Utils: import_time_series 
+using Autarky.Utils: import_time_series
 
 
 """
@@ -6,6 +6,9 @@ This script performs the following steps for each predefined model folder:
 2. Executes the model by temporarily switching into its `src` folder.
 3. Checks whether the model produces output files in the `results` folder.
 
+The Autarky package API (`load_problem`, `build_model`, `solve_model!`) is tested first, on the same
+inputs, by test_package.jl, and the exact CDF kernels of the JCC operators by test_jcc_kernels.jl.
+
 Models tested:
 - Deterministic Model
 - Expected Values Model
@@ -13,7 +16,8 @@ Models tested:
 - JCC Model
 
 This script is intended to be used in both local development and continuous integration (CI)
-to ensure that the model code is runnable and generates expected output artifacts.
+to ensure that the model code is runnable and generates expected output artifacts. Run it in the root
+environment, which provides the Autarky package: `julia --project=. tests/test.jl`.
 """
 
 using Test, Dates, Printf
@@ -29,6 +33,12 @@ const MODEL_FOLDERS = [
 @info("AUTARKY MODEL TESTS")
 @info("Starting Autarky model tests at $(now())")
 
+# Package API on the bundled inputs
+include(joinpath(@__DIR__, "test_package.jl"))
+
+# Exact bivariate and trivariate normal CDF kernels of the JCC model
+include(joinpath(@__DIR__, "test_jcc_kernels.jl"))
+
 # Iterate through each model and perform checks
 for model in MODEL_FOLDERS
     @info("Testing model: $model")
@@ -0,0 +1,93 @@
+"""
+Tests of the exact bivariate and trivariate normal CDF kernels of the JCC operators (`bvn_cdf`, `tvn_cdf`,
+`exact_cdf`) against closed forms and a high-sample quasi-Monte Carlo reference (MvNormalCDF), at negative,
+zero and near ±1 correlations and at extreme limits.
+"""
+
+using Test, LinearAlgebra, Random, Distributions, MvNormalCDF
+using Autarky.JCCOperators: bvn_cdf, tvn_cdf, exact_cdf
+
+Φ(x) = cdf(Normal(), x)
+
+# QMC reference of P(X ≤ b) for X ~ N(0, Σ) and the tolerance of a comparison with it
+function reference_cdf(Σ::Matrix{Float64}, b::Vector{Float64})
+    p, err = mvnormcdf(zeros(length(b)), Σ, fill(-Inf, length(b)), b; m=200_000, rng=MersenneTwister(1))
+    return p, max(5e-5, 5 * err)
+end
+
+correlation_matrix(r12, r13, r23) = [1.0 r12 r13; r12 1.0 r23; r13 r23 1.0]
+
+const LIMITS = (-2.5, -0.3, 0.0, 1.2)
+
+@testset "JCC exact CDF kernels" begin
+    @testset "bvn_cdf closed forms" begin
+        for h in LIMITS, k in LIMITS
+            @test bvn_cdf(h, k, 0.0) ≈ Φ(h) * Φ(k) atol=1e-14
+            @test bvn_cdf(h, k, 1.0) ≈ Φ(min(h, k)) atol=1e-14
+            @test bvn_cdf(h, k, -1.0) ≈ max(0.0, Φ(h) + Φ(k) - 1) atol=1e-14
+        end
+        for r in (-0.999, -0.95, -0.5, 0.5, 0.95, 0.999)
+            @test bvn_cdf(0.0, 0.0, r) ≈ 1 / 4 + asin(r) / (2 * pi) atol=1e-14
+        end
+    end
+
+    @testset "bvn_cdf against the QMC reference (r = $r)" for r in (-0.999, -0.95, -0.5, 0.0, 0.5, 0.8, 0.95, 0.999)
+        for h in LIMITS, k in LIMITS
+            p, tol = reference_cdf([1.0 r; r 1.0], [h, k])
+            @test bvn_cdf(h, k, r) ≈ p atol=tol
+        end
+    end
+
+    @testset "bvn_cdf extreme limits" begin
+        for k in LIMITS, r in (-0.999, -0.5, 0.0, 0.5, 0.999)
+            @test bvn_cdf(8.0, k, r) ≈ Φ(k) atol=1e-12
+            @test bvn_cdf(-8.0, k, r) ≈ 0.0 atol=1e-12
+            @test bvn_cdf(-37.0, k, r) ≈ 0.0 atol=1e-12
+        end
+    end
+
+    # Correlation triples (r12, r13, r23): independent, one pair only, positive, mixed signs and near-singular
+    triples = [(0.0, 0.0, 0.0), (0.3, 0.0, 0.0), (0.5, 0.5, 0.5), (-0.4, -0.4, 0.3), (0.9, -0.45, -0.45),
+               (-0.999, 0.5, -0.5), (0.999, 0.998, 0.999)]
+
+    @testset "tvn_cdf closed forms" begin
+        for (r12, r13, r23) in triples
+            p, _ = tvn_cdf(0.0, 0.0, 0.0, r12, r13, r23)
+            @test p ≈ (1 + (asin(r12) + asin(r13) + asin(r23)) / (pi / 2)) / 8 atol=1e-12
+        end
+        for h in LIMITS
+            p, _ = tvn_cdf(h, 0.4, -0.7, 0.0, 0.0, 0.0)
+            @test p ≈ Φ(h) * Φ(0.4) * Φ(-0.7) atol=1e-14
+        end
+    end
+
+    @testset "tvn_cdf against the QMC reference $((r12, r13, r23))" for (r12, r13, r23) in triples
+        for h in ((-2.5, -0.3, 1.2), (0.0, 0.0, 0.0), (1.2, 1.2, 1.2), (-0.3, 1.2, -2.5))
+            p, tol = reference_cdf(correlation_matrix(r12, r13, r23), collect(h))
+            value, err = tvn_cdf(h..., r12, r13, r23)
+            @test value ≈ p atol=tol
+            @test err < tol
+        end
+    end
+
+    @testset "tvn_cdf extreme limits" begin
+        for (r12, r13, r23) in triples
+            @test tvn_cdf(8.0, 8.0, 8.0, r12, r13, r23)[1] ≈ 1.0 atol=1e-12
+            @test tvn_cdf(-8.0, 0.5, 0.5, r12, r13, r23)[1] ≈ 0.0 atol=1e-12
+            @test tvn_cdf(8.0, 0.4, -0.3, r12, r13, r23)[1] ≈ bvn_cdf(0.4, -0.3, r23) atol=1e-10
+        end
+    end
+
+    @testset "exact_cdf of a scaled covariance" begin
+        σ = [2.0, 0.5, 1.5]
+        for (r12, r13, r23) in triples[1:end-1]
+            Σ = Diagonal(σ) * correlation_matrix(r12, r13, r23) * Diagonal(σ)
+            b = [1.0, -0.2, 0.7]
+            L = cholesky(Symmetric(Σ)).L
+            @test exact_cdf(L[1:2, 1:2], b[1:2])[1] ≈ bvn_cdf(b[1] / σ[1], b[2] / σ[2], r12) atol=1e-14
+            @test exact_cdf(L, b)[1] ≈ tvn_cdf((b ./ σ)..., r12, r13, r23)[1] atol=1e-10
+            p, tol = reference_cdf(Matrix(Σ), b)
+            @test exact_cdf(L, b)[1] ≈ p atol=tol
+        end
+    end
+end
@@ -0,0 +1,176 @@
+"""
+Tests of the Autarky package API on the bundled inputs of the four model folders.
+
+This script calls the package directly, without the `main.jl` scripts:
+1. `load_problem` reads each inputs folder into a typed `AutarkyProblem`.
+2. `build_model` dispatches on the formulation and returns a well-formed model for each of them.
+3. `solve_model!` solves a built model (Expected Values inputs on Ipopt).
+4. `scaling_settings` leaves the NPC of the deterministic inputs unchanged (HiGHS, which needs no license).
+5. The rolling and explicit SOC-under-reserve rows (`reserve_formulation`) give the same NPC on the linear
+   (tangent cuts) Expected Values model, and the same SOC bounds for horizons up to and beyond D + 1.
+6. A model updated in place by `update_model!` (parametric sweeps) reaches the NPC of a model built from scratch
+   with the same parameter value, on the linear models (HiGHS).
+"""
+
+using Test, JuMP, HiGHS
+using Autarky
+
+inputs_dir(model) = joinpath(@__DIR__, "..", "autarky", model, "inputs")
+
+# Inputs of a folder solved as a linear model on HiGHS (tangent cuts of the shortfall, without refinement rounds)
+function linear_problem(folder)
+    problem = load_problem(inputs_dir(folder))
+    problem.parameters["solver_settings"]["solver"] = "highs"
+    if problem.uncertainty.enabled
+        merge!(problem.parameters["shortfall_settings"],
+               Dict("formulation" => "tangent_cuts", "lp_solver" => "highs", "refinement_iterations" => 0))
+    end
+    return problem
+end
+
+# Swept parameters checked against a fresh build, with their values
+const SWEEPS = [
+    ("deterministic", Deterministic, "fuel_cost", [1.0, 1.6]),
+    ("deterministic", Deterministic, "generator_capex", [200.0, 500.0]),
+    ("expected_values", ExpectedValues, "grid_exchange_cost", [0.1, 0.6]),
+    ("icc", ICC, "grid_exchange_cost", [0.1, 0.6]),
+    ("icc", ICC, "islanding_probability", [0.8, 0.95]),
+]
+
+# Copy of a problem with other SOC-under-reserve rows
+with_reserve_formulation(problem, reserve_formulation) =
+    Autarky.replace_field(problem, :uncertainty, Autarky.replace_field(problem.uncertainty, :reserve_formulation, reserve_formulation))
+
+# Model folder of each formulation
+const FORMULATIONS = [
+    ("deterministic", Deterministic),
+    ("expected_values", ExpectedValues),
+    ("icc", ICC),
+    ("jcc_genz", JCC),
+]
+
+@testset "Autarky package" begin
+    @testset "load_problem: $folder" for (folder, _) in FORMULATIONS
+        problem = load_problem(inputs_dir(folder))
+        @test problem isa AutarkyProblem
+        @test size(problem.load) == (problem.operation_time_steps, problem.S)
+        if problem.solar.enabled
+            @test size(problem.solar_unit_production) == size(problem.load)
+        end
+        @test length(problem.discount_factor) == problem.project_lifetime
+    end
+
+    @testset "uncertainty formulations need uncertainty_settings" begin
+        problem = load_problem(inputs_dir("deterministic"))
+        @test !problem.uncertainty.enabled
+        @test_throws ErrorException ICC(problem)
+        @test_throws ErrorException JCC(problem)
+    end
+
+    @testset "build_model: $Formulation" for (folder, Formulation) in FORMULATIONS
+        problem = load_problem(inputs_dir(folder))
+        formulation = Formulation(problem)
+        model = build_model(problem, formulation)
+        T = horizon(problem, formulation)
+
+        # Shared rows and objective
+        @test model isa Model
+        @test num_variables(model) > 0
+        @test objective_sense(model) == MIN_SENSE
+        @test haskey(model, :NPC)
+        if problem.battery.enabled
+            @test size(model[:SOC]) == (T, problem.S)
+        end
+
+        # Rows of each formulation
+        if formulation isa Deterministic
+            @test T == problem.operation_time_steps
+            @test !haskey(model, :battery_reserve)
+            @test num_nonlinear_constraints(model) == 0
+        else
+            @test T == problem.operation_time_steps + problem.uncertainty.outage_duration
+            @test haskey(model, :expected_shortfall)
+            @test haskey(model, :battery_reserve) || !problem.battery.enabled
+        end
+        @test haskey(model, :reserve_mismatch) == (formulation isa JCC)
+        if formulation isa JCC
+            D = problem.uncertainty.outage_duration
+            @test length(model.ext[:jcc].window_starts) == (T - D) * problem.S
+            @test num_nonlinear_constraints(model) >= (T - D) * problem.S
+        end
+    end
+
+    @testset "build_model → solve_model!" begin
+        problem = load_problem(inputs_dir("expected_values"))
+        formulation = ExpectedValues(problem)
+        model = build_model(problem, formulation)
+        status = solve_model!(model, problem, formulation)
+        @test status in (MOI.LOCALLY_SOLVED, MOI.ALMOST_LOCALLY_SOLVED)
+        @test objective_value(model) ≈ value(model[:NPC]) rtol=1e-6
+        @test value(model[:NPC]) > 0
+    end
+
+    @testset "scaling_settings: same NPC with and without scaling" begin
+        npc = Dict{Bool, Float64}()
+        for enabled in (false, true)
+            problem = load_problem(inputs_dir("deterministic"))
+            problem.parameters["solver_settings"]["solver"] = "highs"
+            problem.parameters["scaling_settings"] = Dict("enabled" => enabled)
+            formulation = Deterministic(problem)
+            model = build_model(problem, formulation)
+            @test solve_model!(model, problem, formulation) == MOI.OPTIMAL
+            @test objective_value(model) * objective_scale(model) ≈ value(model[:NPC]) rtol=1e-6
+            npc[enabled] = value(model[:NPC])
+        end
+        @test npc[true] ≈ npc[false] rtol=1e-5
+    end
+
+    @testset "reserve_formulation: same NPC with rolling and explicit rows" begin
+        npc = Dict{String, Float64}()
+        for reserve_formulation in ("rolling", "explicit")
+            problem = with_reserve_formulation(linear_problem("expected_values"), reserve_formulation)
+            formulation = ExpectedValues(problem)
+            model = build_model(problem, formulation)
+            @test solve_model!(model, problem, formulation) == MOI.OPTIMAL
+            npc[reserve_formulation] = value(model[:NPC])
+        end
+        @test npc["explicit"] ≈ npc["rolling"] rtol=1e-6
+    end
+
+    @testset "reserve_formulation: same SOC bounds for horizons T ≤ D + 1 and beyond" begin
+        problem = load_problem(inputs_dir("expected_values"))
+        S = problem.S
+        D = problem.uncertainty.outage_duration
+        for T in 1:D+3
+            soc = Dict{String, Matrix{Float64}}()
+            for reserve_formulation in ("rolling", "explicit")
+                model = Model(HiGHS.Optimizer)
+                set_silent(model)
+                @variable(model, SOC[1:T, 1:S])
+                @variable(model, battery_reserve[1:T, 1:S])
+                fix.(battery_reserve, [1.0 + mod(3 * t + s, 5) for t in 1:T, s in 1:S])
+                Autarky.add_soc_under_reserves!(model, with_reserve_formulation(problem, reserve_formulation), T)
+                # Lowest SOC allowed by the rows at each time step
+                @objective(model, Min, sum(SOC))
+                optimize!(model)
+                @test termination_status(model) == MOI.OPTIMAL
+                soc[reserve_formulation] = value.(SOC)
+            end
+            @test soc["explicit"] ≈ soc["rolling"] atol=1e-7
+        end
+    end
+
+    @testset "update_model!: same NPC as a fresh build ($Formulation, $parameter)" for (folder, Formulation, parameter, values) in SWEEPS
+        base = linear_problem(folder)
+        formulation = Formulation(base)
+        model = build_model(base, formulation)
+        for x in values
+            problem = Autarky.set_parameter(base, parameter, x)
+            Autarky.update_model!(model, problem, formulation, parameter)
+            @test solve_model!(model, problem, formulation) == MOI.OPTIMAL
+            fresh = build_model(problem, Formulation(problem))
+            @test solve_model!(fresh, problem, Formulation(problem)) == MOI.OPTIMAL
+            @test value(model[:NPC]) ≈ value(fresh[:NPC]) rtol=1e-6
+        end
+    end
+end